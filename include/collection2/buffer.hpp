@@ -16,8 +16,10 @@ namespace collection2 {
  *
  * @tparam Element
  * @tparam Size
+ * @tparam Policy 並行性ポリシー (割り込みハンドラと共有する場合は `interrupt.hpp` のポリシーを指定します)
+ * @tparam Indexing 添字ポリシー (領域全体を使用する場合は `ExactCapacity` を指定します)
  */
-template <typename Element, typename Size = size_t>
+template <typename Element, typename Size = size_t, typename Policy = SingleContext, typename Indexing = PowerOfTwoCapacity>
 class Buffer {
    private:
     /**
@@ -51,9 +53,10 @@ class Buffer {
      *
      * @param data 内部データ保管用領域
      * @param dataSize 領域サイズ
-     * @note 領域サイズは2の冪乗であるべきです。それ以外の値を指定した場合、2の冪数のうち領域のサイズを下回らない最大のものが選択されます(15 -> 8, 34 -> 32).
+     * @note 既定の添字ポリシーでは、領域サイズは2の冪乗であるべきです。それ以外の値を指定した場合、2の冪数のうち領域のサイズを下回らない最大のものが選択されます(15 -> 8, 34 -> 32).
+     *       `ExactCapacity` を指定した場合は領域全体が使用されます。
      */
-    Buffer(Element* const data, const Size& dataSize);
+    constexpr Buffer(Element* const data, const Size& dataSize);
 
     Buffer(const Buffer&) = delete;
     Buffer& operator=(const Buffer&) = delete;
@@ -66,7 +69,7 @@ class Buffer {
      * @param data 追加するデータ
      * @return OperationResult 操作結果
      */
-    OperationResult append(const Element& data);
+    COLLECTION2_CONSTEXPR14 OperationResult append(const Element& data);
 
     /**
      * @brief バッファの先頭からデータを取り出し
@@ -74,14 +77,14 @@ class Buffer {
      * @param data 取り出したデータの格納先
      * @return OperationResult 操作結果
      */
-    OperationResult pop(Element* const data);
+    COLLECTION2_CONSTEXPR14 OperationResult pop(Element* const data);
 
     /**
      * @brief バッファの全体長を返す
      *
      * @return Size バッファ長
      */
-    Size capacity() const {
+    constexpr Size capacity() const {
         return internalDataSize;
     }
 
@@ -90,7 +93,7 @@ class Buffer {
      *
      * @return Size バッファ内に存在するデータの数
      */
-    Size amount() const {
+    constexpr Size amount() const {
         return count;
     }
 
@@ -99,7 +102,7 @@ class Buffer {
      *
      * @return bool
      */
-    bool hasSpace() const {
+    constexpr bool hasSpace() const {
         return count < internalDataSize;
     }
 
@@ -108,30 +111,17 @@ class Buffer {
      *
      * @return bool
      */
-    bool isEmpty() const {
+    constexpr bool isEmpty() const {
         return count == 0;
     }
 };
 
-template <typename Element, typename Size>
-Buffer<Element, Size>::Buffer(Element* const data, const Size& dataSize) : internalData(data) {
-    // ゼロ長のバッファなら何もしない
-    if (dataSize == 0) {
-        internalDataSize = dataSize;
-        return;
-    }
-
-    // 与えられたサイズを上回らない最大の2の冪数を探す
-    unsigned char maxbitPos = 0;
-    Size size = dataSize;
-    while ((size >>= 1) != 0) {
-        maxbitPos++;
-    }
-    internalDataSize = 1 << maxbitPos;
-};
+template <typename Element, typename Size, typename Policy, typename Indexing>
+constexpr Buffer<Element, Size, Policy, Indexing>::Buffer(Element* const data, const Size& dataSize)
+    : internalData(data), internalDataSize(Indexing::capacityOf(dataSize)){};
 
-template <typename Element, typename Size>
-OperationResult Buffer<Element, Size>::append(const Element& data) {
+template <typename Element, typename Size, typename Policy, typename Indexing>
+COLLECTION2_CONSTEXPR14 OperationResult Buffer<Element, Size, Policy, Indexing>::append(const Element& data) {
     // サイズ0のバッファに値を追加することはできない
     if (internalDataSize == 0) {
         return OperationResult::Overflow;
@@ -145,14 +135,14 @@ OperationResult Buffer<Element, Size>::append(const Element& data) {
     // tailの位置にデータを書き込む
     *(internalData + tail) = data;
 
-    tail = (tail + 1) & (internalDataSize - 1);
+    tail = Indexing::advance(tail, static_cast<Size>(1), internalDataSize);
     count++;
 
     return OperationResult::Success;
 }
 
-template <typename Element, typename Size>
-OperationResult Buffer<Element, Size>::pop(Element* const data) {
+template <typename Element, typename Size, typename Policy, typename Indexing>
+COLLECTION2_CONSTEXPR14 OperationResult Buffer<Element, Size, Policy, Indexing>::pop(Element* const data) {
     // バッファが空なら戻る
     if (isEmpty()) {
         return OperationResult::Empty;
@@ -163,7 +153,7 @@ OperationResult Buffer<Element, Size>::pop(Element* const data) {
         *data = *(internalData + head);
     }
 
-    head = (head + 1) & (internalDataSize - 1);
+    head = Indexing::advance(head, static_cast<Size>(1), internalDataSize);
     count--;
 
     return OperationResult::Success;
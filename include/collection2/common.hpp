@@ -6,6 +6,17 @@
 #ifndef COLLECTION2_COMMON_H
 #define COLLECTION2_COMMON_H
 
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @brief キャッシュラインの大きさ (バイト)
+ * @note スレッド間で共有するコンテナは、各スレッドが書き換える状態をこの境界で分離します。対象環境に合わせて再定義できます。
+ */
+#ifndef COLLECTION2_CACHE_LINE_SIZE
+#define COLLECTION2_CACHE_LINE_SIZE 64
+#endif
+
 namespace collection2 {
 
 /**
@@ -29,6 +40,367 @@ enum class OperationResult {
     Empty
 };
 
+/**
+ * @brief C++14以降でのみconstexprとする関数に付ける指定子
+ * @note C++11のconstexpr関数は単一のreturn文しか持てないため、状態を書き換える操作はC++14以降でのみ定数式で使用できます。
+ */
+#if __cplusplus >= 201402L
+#define COLLECTION2_CONSTEXPR14 constexpr
+#else
+#define COLLECTION2_CONSTEXPR14
+#endif
+
+/**
+ * @brief 並行性ポリシー: 排他制御を行わない (既定)
+ * @note コンテナを一つの実行コンテキストからのみ操作する場合に使用します。
+ */
+struct SingleContext {};
+
+/**
+ * @brief 並行性ポリシー: 複数のスレッドから同時に、ロックを使わずに操作する (ホスト環境のみ)
+ * @note オブジェクトプール (`concurrent_pool.hpp`) と、それを使うリスト・ツリー、およびトリプルバッファに指定できます。
+ */
+struct LockFree {};
+
+/**
+ * @brief 並行性ポリシー: 他のコンテナと共有するプールからノードを確保する (排他制御を行わない)
+ * @note リスト・ツリーに指定すると、コンテナは専用のプールを持たず、共有プールへのポインタだけを持ちます。
+ */
+struct SharedPool {};
+
+namespace internal {
+
+/**
+ * @brief コンパイラによるメモリアクセスの並べ替えを抑止する
+ * @note 要素の書き込みとインデックスの公開の順序を保つ必要がある箇所で使用します。
+ */
+inline void compilerBarrier() {
+#if defined(__GNUC__)
+    __asm__ __volatile__("" ::: "memory");
+#endif
+}
+
+/**
+ * @brief 値を上回らない最大の2の冪数を求める (15 -> 8, 34 -> 32)
+ *
+ * @param value 対象の値
+ * @param power 探索中の2の冪数 (呼び出し側は指定しない)
+ * @return Size 値を上回らない最大の2の冪数。値が0なら0
+ * @note コンストラクタの初期化子から呼べるよう、C++11のconstexpr関数として再帰で記述しています。
+ */
+template <typename Size>
+constexpr Size floorPowerOfTwo(const Size value, const Size power = 1) {
+    return value == 0 ? 0 : (value / 2 < power ? power : floorPowerOfTwo(value, static_cast<Size>(power * 2)));
+}
+
+/**
+ * @brief 型がトリビアルにコピー可能かどうか
+ *
+ * @tparam T 対象の型
+ * @note AVR環境では `<type_traits>` が使えないため、標準ライブラリの実装と同じコンパイラ組み込み関数を直接使用します。
+ *       組み込み関数のないコンパイラでは常にfalseとなり、要素ごとの代入にフォールバックします。
+ */
+template <typename T>
+struct IsTriviallyCopyable {
+#if defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER)
+    static constexpr bool value = __is_trivially_copyable(T);
+#else
+    static constexpr bool value = false;
+#endif
+};
+
+/**
+ * @brief 要素の配列をコピーする (要素ごとの代入)
+ *
+ * @tparam Trivial 要素がトリビアルにコピー可能か
+ */
+template <bool Trivial>
+struct ElementCopier {
+    template <typename T>
+    static void copy(T* const destination, const T* const source, const size_t length) {
+        for (size_t i = 0; i < length; i++) {
+            destination[i] = source[i];
+        }
+    }
+};
+
+/**
+ * @brief 要素の配列をコピーする (memcpy)
+ */
+template <>
+struct ElementCopier<true> {
+    template <typename T>
+    static void copy(T* const destination, const T* const source, const size_t length) {
+        memcpy(static_cast<void*>(destination), static_cast<const void*>(source), sizeof(T) * length);
+    }
+};
+
+/**
+ * @brief 重ならない要素の配列をまとめてコピーする
+ *
+ * @param destination コピー先
+ * @param source コピー元
+ * @param length 要素数
+ * @note トリビアルにコピー可能な型ではmemcpyを使用し、それ以外は要素ごとに代入します。
+ */
+template <typename T>
+inline void copyElements(T* const destination, const T* const source, const size_t length) {
+    ElementCopier<IsTriviallyCopyable<T>::value>::copy(destination, source, length);
+}
+
+/**
+ * @brief 配置newのオーバーロードを識別するためのタグ
+ * @note `<new>` を持たない処理系(avr-gcc等)でも配置構築を行えるよう、ライブラリ独自のオーバーロードを定義しています。
+ */
+struct PlacementTag {};
+
+}  // namespace internal
+
+/**
+ * @brief 添字ポリシー: 容量を2の冪数に丸め、ビットマスクで折り返す (既定)
+ * @note 折り返しは論理積一回で済みますが、領域のうち2の冪数を超える部分は使用されません(15 -> 8, 34 -> 32)。
+ * @note 容量で丸めずに増え続けるインデックスは、Sizeの桁あふれによってそのまま折り返します。
+ */
+struct PowerOfTwoCapacity {
+    /**
+     * @brief 領域サイズから実際に使用する容量を求める
+     *
+     * @param dataSize 領域サイズ
+     * @return Size 容量
+     */
+    template <typename Size>
+    static constexpr Size capacityOf(const Size& dataSize) {
+        return internal::floorPowerOfTwo(dataSize);
+    }
+
+    /**
+     * @brief 容量で丸めずに増え続けるインデックスだけで管理する場合の容量を求める
+     *
+     * @param dataSize 領域サイズ
+     * @return Size 容量 (capacityOfと同じ)
+     */
+    template <typename Size>
+    static constexpr Size freeRunningCapacityOf(const Size& dataSize) {
+        return capacityOf(dataSize);
+    }
+
+    /**
+     * @brief キューの先頭・末尾 (容量で丸めずに増え続け、その差をデータ数とする)
+     *
+     * @tparam Size 要素数の型
+     * @note 追加は末尾だけを、取り出しは先頭だけを書き換えます。
+     */
+    template <typename Size>
+    struct QueueCursor {
+        Size head = 0;
+        Size tail = 0;
+
+        constexpr Size amount(const Size&) const {
+            return static_cast<Size>(tail - head);
+        }
+
+        constexpr Size headSlot(const Size& capacity) const {
+            return slotOf(head, capacity);
+        }
+
+        constexpr Size tailSlot(const Size& capacity) const {
+            return slotOf(tail, capacity);
+        }
+
+        COLLECTION2_CONSTEXPR14 void pushed(const Size& length, const Size&) {
+            tail = static_cast<Size>(tail + length);
+        }
+
+        COLLECTION2_CONSTEXPR14 void popped(const Size& length, const Size&) {
+            head = static_cast<Size>(head + length);
+        }
+    };
+
+    /**
+     * @brief 容量内の位置をn個進める
+     *
+     * @param index 現在の位置 (容量未満)
+     * @param length 進める数 (容量以下)
+     * @param capacity 容量
+     * @return Size 進めた位置
+     */
+    template <typename Size>
+    static constexpr Size advance(const Size& index, const Size& length, const Size& capacity) {
+        return static_cast<Size>(index + length) & static_cast<Size>(capacity - 1);
+    }
+
+    /**
+     * @brief 容量で丸めずに増え続けるインデックスに対応する、容量内の位置を求める
+     *
+     * @param index インデックス
+     * @param capacity 容量
+     * @return Size 容量内の位置
+     */
+    template <typename Size>
+    static constexpr Size slotOf(const Size& index, const Size& capacity) {
+        return index & static_cast<Size>(capacity - 1);
+    }
+
+    /**
+     * @brief 容量で丸めずに増え続けるインデックスをn個進める
+     *
+     * @param index インデックス
+     * @param length 進める数 (容量以下)
+     * @param capacity 容量
+     * @return Size 進めたインデックス
+     */
+    template <typename Size>
+    static constexpr Size step(const Size& index, const Size& length, const Size&) {
+        return static_cast<Size>(index + length);
+    }
+
+    /**
+     * @brief 容量で丸めずに増え続ける二つのインデックスの差を求める
+     *
+     * @param tail 末尾のインデックス
+     * @param head 先頭のインデックス
+     * @param capacity 容量
+     * @return Size 二つのインデックスの間にある要素の数
+     */
+    template <typename Size>
+    static constexpr Size distance(const Size& tail, const Size& head, const Size&) {
+        return static_cast<Size>(tail - head);
+    }
+};
+
+/**
+ * @brief 添字ポリシー: 領域全体を容量とし、比較と減算で折り返す
+ * @note 除算は使用しません。折り返しの分岐が一つ増える代わりに、渡した領域を全て使用できます。
+ * @note キューは位置とデータ数を持つため、容量はSizeの最大値まで使用できます。
+ *       データ数を持てない割り込み用のキュー・バッファでは、容量で丸めずに増え続けるインデックスを容量の2倍の範囲で巡回させるため、
+ *       容量はSizeの最大値の半分までとなります(`uint8_t` なら127, `freeRunningCapacityOf` を参照)。
+ */
+struct ExactCapacity {
+    /**
+     * @brief 領域サイズから実際に使用する容量を求める
+     *
+     * @param dataSize 領域サイズ
+     * @return Size 容量 (領域サイズそのもの)
+     */
+    template <typename Size>
+    static constexpr Size capacityOf(const Size& dataSize) {
+        return dataSize;
+    }
+
+    /**
+     * @brief 容量で丸めずに増え続けるインデックスだけで管理する場合の容量を求める
+     *
+     * @param dataSize 領域サイズ
+     * @return Size 容量 (インデックスが容量の2倍を表せるよう、Sizeの最大値の半分まで)
+     */
+    template <typename Size>
+    static constexpr Size freeRunningCapacityOf(const Size& dataSize) {
+        return dataSize < static_cast<Size>(static_cast<Size>(~static_cast<Size>(0)) / 2) ? dataSize : static_cast<Size>(static_cast<Size>(~static_cast<Size>(0)) / 2);
+    }
+
+    /**
+     * @brief キューの先頭・末尾 (容量内の位置とデータ数)
+     *
+     * @tparam Size 要素数の型
+     * @note 容量の2倍をSizeで表せなくても、容量全体を使用できます。
+     */
+    template <typename Size>
+    struct QueueCursor {
+        Size head = 0;
+        Size tail = 0;
+        Size count = 0;
+
+        constexpr Size amount(const Size&) const {
+            return count;
+        }
+
+        constexpr Size headSlot(const Size&) const {
+            return head;
+        }
+
+        constexpr Size tailSlot(const Size&) const {
+            return tail;
+        }
+
+        COLLECTION2_CONSTEXPR14 void pushed(const Size& length, const Size& capacity) {
+            tail = advance(tail, length, capacity);
+            count = static_cast<Size>(count + length);
+        }
+
+        COLLECTION2_CONSTEXPR14 void popped(const Size& length, const Size& capacity) {
+            head = advance(head, length, capacity);
+            count = static_cast<Size>(count - length);
+        }
+    };
+
+    /**
+     * @brief 容量内の位置をn個進める
+     *
+     * @param index 現在の位置 (容量未満)
+     * @param length 進める数 (容量以下)
+     * @param capacity 容量
+     * @return Size 進めた位置
+     * @note 折り返しの要否を残りの長さと比較して判定するため、容量がSizeの最大値に近くても桁あふれしません。
+     */
+    template <typename Size>
+    static constexpr Size advance(const Size& index, const Size& length, const Size& capacity) {
+        return length >= static_cast<Size>(capacity - index) ? static_cast<Size>(length - (capacity - index)) : static_cast<Size>(index + length);
+    }
+
+    /**
+     * @brief 容量で丸めずに増え続けるインデックスに対応する、容量内の位置を求める
+     *
+     * @param index インデックス (容量の2倍未満)
+     * @param capacity 容量
+     * @return Size 容量内の位置
+     */
+    template <typename Size>
+    static constexpr Size slotOf(const Size& index, const Size& capacity) {
+        return index >= capacity ? static_cast<Size>(index - capacity) : index;
+    }
+
+    /**
+     * @brief 容量で丸めずに増え続けるインデックスをn個進める
+     *
+     * @param index インデックス (容量の2倍未満)
+     * @param length 進める数 (容量以下)
+     * @param capacity 容量
+     * @return Size 進めたインデックス (容量の2倍で折り返す)
+     */
+    template <typename Size>
+    static constexpr Size step(const Size& index, const Size& length, const Size& capacity) {
+        return advance(index, length, static_cast<Size>(capacity * 2));
+    }
+
+    /**
+     * @brief 容量で丸めずに増え続ける二つのインデックスの差を求める
+     *
+     * @param tail 末尾のインデックス
+     * @param head 先頭のインデックス
+     * @param capacity 容量
+     * @return Size 二つのインデックスの間にある要素の数
+     */
+    template <typename Size>
+    static constexpr Size distance(const Size& tail, const Size& head, const Size& capacity) {
+        return tail >= head ? static_cast<Size>(tail - head) : static_cast<Size>(tail + (capacity * 2 - head));
+    }
+};
+
 }  // namespace collection2
 
+/**
+ * @brief 確保済みの領域にオブジェクトを構築する
+ *
+ * @param ptr 構築先の領域
+ * @return void* 構築先の領域
+ */
+inline void* operator new(size_t, collection2::internal::PlacementTag, void* ptr) noexcept {
+    return ptr;
+}
+
+/**
+ * @brief 配置newに対応するdelete (コンストラクタが例外を送出した場合のみ呼ばれる)
+ */
+inline void operator delete(void*, collection2::internal::PlacementTag, void*) noexcept {}
+
 #endif /* COLLECTION2_COMMON_H */
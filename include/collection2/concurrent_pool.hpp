@@ -0,0 +1,276 @@
+//
+// 複数のスレッドで共有するオブジェクトプール (ホスト環境のみ)
+//
+
+#ifndef COLLECTION2_CONCURRENT_POOL_H
+#define COLLECTION2_CONCURRENT_POOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+
+#include "common.hpp"
+#include "lock_free_stack.hpp"
+#include "pool.hpp"
+
+namespace collection2 {
+
+/**
+ * @brief 複数のスレッドから同時に確保・返却できる固定長オブジェクトプール
+ *
+ * @tparam T 管理するオブジェクトの型
+ * @tparam Size 要素数の型
+ *
+ * @note 返却済みスロットは、タグ付きインデックスで表したロックフリーの単方向リスト (`internal::TaggedIndexHead`) で管理します。
+ *       スロットはプールの外から見れば解放されないため、ABA問題はタグで、遅延解放の問題はそもそも生じません。
+ * @note 次の空きスロットへのリンクは、呼び出し側が用意するアトミック変数の配列に格納します。
+ *       スロット自身の領域に書き込むと、取り出しに負けたスレッドのリンクの読み出しが、新しい所有者によるオブジェクトの構築と競合するためです。
+ * @note 一度も払い出されていない領域は、比較交換でその先頭を進めて切り出します。
+ * @note 同じプールを共有する個々のリストやツリーは、それぞれ一つのスレッドから操作する必要があります。
+ *       `LockFree` ポリシーのリスト・ツリーは専用のプールを持たず、このプールへのポインタだけを保持します。
+ */
+template <typename T, typename Size>
+class Pool<T, Size, LockFree> {
+   private:
+    /**
+     * @brief 返却済みスロットのリンクを読み書きするオブジェクト
+     */
+    struct SlotLinks {
+        std::atomic<uint32_t>* const links;
+
+        uint32_t load(const uint32_t index) const {
+            return links[index].load(std::memory_order_relaxed);
+        }
+
+        void store(const uint32_t index, const uint32_t next) const {
+            links[index].store(next, std::memory_order_relaxed);
+        }
+    };
+
+    /**
+     * @brief 内部データ管理領域
+     */
+    T* const internalData;
+
+    /**
+     * @brief 返却済みスロットのリンク
+     */
+    const SlotLinks slotLinks;
+
+    /**
+     * @brief 内部データ長さ
+     */
+    Size internalDataSize;
+
+    /**
+     * @brief まだ一度も払い出されていない領域の先頭
+     */
+    alignas(COLLECTION2_CACHE_LINE_SIZE) std::atomic<Size> untouchedHead;
+
+    /**
+     * @brief 返却済みスロットのリストの先頭
+     */
+    alignas(COLLECTION2_CACHE_LINE_SIZE) internal::TaggedIndexHead freeHead;
+
+    /**
+     * @brief 払い出し中のオブジェクト数
+     */
+    alignas(COLLECTION2_CACHE_LINE_SIZE) std::atomic<Size> count;
+
+    /**
+     * @brief 空きスロットを一つ取り出す
+     *
+     * @return void* オブジェクトを構築できる領域。空きがない場合はnullptrが返ります。
+     */
+    void* takeSlot();
+
+   public:
+    /**
+     * @brief 内部データを扱う領域とリンクを格納する領域を指定してプールを初期化
+     *
+     * @param data 内部データ保管用領域
+     * @param dataSize 領域サイズ
+     * @param links リンク保管用領域 (dataSize個の要素を持つ必要があります)
+     * @note リンク保管用領域にnullptrを渡した場合、プールは空(容量0)として扱われます。
+     * @note 構築は他のスレッドと共有する前に行う必要があります。
+     */
+    Pool(T* const data, const Size& dataSize, std::atomic<uint32_t>* const links);
+
+    Pool(const Pool&) = delete;
+    Pool& operator=(const Pool&) = delete;
+
+    /**
+     * @brief プールを破棄する
+     * @note 呼び出し側の領域には触れません (単一コンテキストのプールと同様です)。
+     */
+    ~Pool() = default;
+
+    /**
+     * @brief オブジェクトをデフォルト構築して払い出す (任意のスレッドから呼び出せる)
+     *
+     * @return T* 払い出したオブジェクトへのポインタ
+     * @note 空きスロットがない場合はnullptrが返ります。他のスレッドが返却している最中であれば、空きがあってもnullptrとなることがあります。
+     */
+    T* acquire();
+
+    /**
+     * @brief オブジェクトをコピー構築して払い出す (任意のスレッドから呼び出せる)
+     *
+     * @param value 構築元の値
+     * @return T* 払い出したオブジェクトへのポインタ
+     * @note 空きスロットがない場合はnullptrが返ります。
+     */
+    T* acquire(const T& value);
+
+    /**
+     * @brief オブジェクトを破棄し、プールに返却する (任意のスレッドから呼び出せる)
+     *
+     * @param object 返却するオブジェクト
+     * @return OperationResult 操作結果
+     * @note このプールが払い出したものでないポインタを渡した場合は何もせずEmptyが返ります。二重返却は検出しません。
+     */
+    OperationResult release(T* const object);
+
+    /**
+     * @brief プールを初期状態に戻す
+     * @note 払い出し中のオブジェクトも含め、全てのスロットが空きとして扱われます。他のスレッドがプールを操作していない状態で呼び出してください。
+     */
+    void reset();
+
+    /**
+     * @brief ポインタがこのプールの管理領域内を指しているか
+     *
+     * @param object 調べるポインタ
+     * @return bool
+     */
+    bool owns(const T* const object) const {
+        return object != nullptr && object >= internalData && object < internalData + internalDataSize;
+    }
+
+    /**
+     * @brief プールの全体長を返す
+     *
+     * @return Size プール長
+     */
+    Size capacity() const {
+        return internalDataSize;
+    }
+
+    /**
+     * @brief 払い出し中のオブジェクト数を返す
+     *
+     * @return Size 払い出し中のオブジェクト数
+     * @note 他のスレッドが操作している間は、呼び出した時点での近似値となります。
+     */
+    Size amount() const {
+        return count.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief オブジェクトを払い出せるか
+     *
+     * @return bool
+     */
+    bool hasSpace() const {
+        return amount() < internalDataSize;
+    }
+
+    /**
+     * @brief 払い出し中のオブジェクトがないか
+     *
+     * @return bool
+     */
+    bool isEmpty() const {
+        return amount() == 0;
+    }
+};
+
+template <typename T, typename Size>
+Pool<T, Size, LockFree>::Pool(T* const data, const Size& dataSize, std::atomic<uint32_t>* const links)
+    : internalData(data),
+      slotLinks{links},
+      internalDataSize(links == nullptr ? 0 : (static_cast<uint64_t>(dataSize) < internal::TaggedIndexHead::nullIndex ? dataSize : static_cast<Size>(internal::TaggedIndexHead::nullIndex))),
+      untouchedHead(0),
+      freeHead(),
+      count(0) {}
+
+template <typename T, typename Size>
+void* Pool<T, Size, LockFree>::takeSlot() {
+    // 返却済みスロットがあればそれを使う
+    uint32_t index = freeHead.pop(slotLinks);
+    if (index != internal::TaggedIndexHead::nullIndex) {
+        return internalData + index;
+    }
+
+    // 未使用領域から切り出す 呼び出し側が構築したオブジェクトはここで破棄する
+    Size current = untouchedHead.load(std::memory_order_relaxed);
+    while (current < internalDataSize) {
+        if (untouchedHead.compare_exchange_weak(current, static_cast<Size>(current + 1), std::memory_order_relaxed)) {
+            T* slot = internalData + current;
+            slot->~T();
+            return slot;
+        }
+    }
+
+    // 未使用領域を使い切る間に返却されたスロットがあるかもしれない
+    index = freeHead.pop(slotLinks);
+    if (index != internal::TaggedIndexHead::nullIndex) {
+        return internalData + index;
+    }
+    return nullptr;
+}
+
+template <typename T, typename Size>
+T* Pool<T, Size, LockFree>::acquire() {
+    void* slot = takeSlot();
+    if (slot == nullptr) {
+        return nullptr;
+    }
+
+    count.fetch_add(1, std::memory_order_relaxed);
+    return new (internal::PlacementTag(), slot) T();
+}
+
+template <typename T, typename Size>
+T* Pool<T, Size, LockFree>::acquire(const T& value) {
+    void* slot = takeSlot();
+    if (slot == nullptr) {
+        return nullptr;
+    }
+
+    count.fetch_add(1, std::memory_order_relaxed);
+    return new (internal::PlacementTag(), slot) T(value);
+}
+
+template <typename T, typename Size>
+OperationResult Pool<T, Size, LockFree>::release(T* const object) {
+    if (!owns(object)) {
+        return OperationResult::Empty;
+    }
+
+    // オブジェクトを破棄し、空いた領域を返却済みリストの先頭に繋ぐ
+    object->~T();
+    freeHead.push(slotLinks, static_cast<uint32_t>(object - internalData));
+    count.fetch_sub(1, std::memory_order_relaxed);
+
+    return OperationResult::Success;
+}
+
+template <typename T, typename Size>
+void Pool<T, Size, LockFree>::reset() {
+    // 返却済みスロットにオブジェクトを置き直す
+    uint32_t index = freeHead.pop(slotLinks);
+    while (index != internal::TaggedIndexHead::nullIndex) {
+        new (internal::PlacementTag(), internalData + index) T();
+        index = freeHead.pop(slotLinks);
+    }
+
+    // 全てのスロットに有効なオブジェクトがある状態 = 未使用領域として扱える
+    untouchedHead.store(0, std::memory_order_relaxed);
+    count.store(0, std::memory_order_relaxed);
+}
+
+}  // namespace collection2
+
+#endif
@@ -0,0 +1,549 @@
+//
+// 割り込みハンドラと共有するキュー・リングバッファ・トリプルバッファ
+//
+
+#ifndef COLLECTION2_INTERRUPT_H
+#define COLLECTION2_INTERRUPT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__AVR__)
+#include <avr/interrupt.h>
+#include <avr/io.h>
+#endif
+
+#include "buffer.hpp"
+#include "common.hpp"
+#include "queue.hpp"
+#include "triple_buffer.hpp"
+
+namespace collection2 {
+
+/**
+ * @brief スコープの間、割り込みを禁止する
+ *
+ * @note AVRではSREGを退避してから割り込みを禁止し、スコープを抜けるときに元の状態へ戻します。
+ *       AVR以外の環境ではコンパイラバリアとしてのみ働きます。
+ */
+class InterruptGuard {
+   private:
+#if defined(__AVR__)
+    /**
+     * @brief 退避したステータスレジスタ
+     */
+    uint8_t savedStatus;
+#endif
+
+   public:
+#if defined(__AVR__)
+    InterruptGuard() : savedStatus(SREG) {
+        cli();
+    }
+
+    ~InterruptGuard() {
+        SREG = savedStatus;
+        internal::compilerBarrier();
+    }
+#else
+    InterruptGuard() {
+        internal::compilerBarrier();
+    }
+
+    ~InterruptGuard() {
+        internal::compilerBarrier();
+    }
+#endif
+
+    InterruptGuard(const InterruptGuard&) = delete;
+    InterruptGuard& operator=(const InterruptGuard&) = delete;
+};
+
+/**
+ * @brief 並行性ポリシー: 割り込みハンドラとメインループの間で、一方が追加し他方が取り出す
+ *
+ * @tparam ProducerIsInterrupt 追加する側が割り込みハンドラか
+ *
+ * @note 追加側・取り出し側はそれぞれ一つのコンテキストに限られます。また、ネストした割り込みは想定していません。
+ */
+template <bool ProducerIsInterrupt>
+struct InterruptSafe {
+    /**
+     * @brief 追加側が割り込みハンドラか
+     */
+    static constexpr bool producerIsInterrupt = ProducerIsInterrupt;
+
+    /**
+     * @brief 他方のコンテキストと共有するインデックスを読む
+     *
+     * @param index 読み出すインデックス
+     * @param fromMain メインループ側から呼び出すか
+     * @return Size 読み出した値
+     * @note メインループ側で1バイトを超えるインデックスを読む場合のみ、その読み出しの間だけ割り込みを禁止します。
+     */
+    template <typename Size>
+    static Size load(const volatile Size& index, const bool fromMain) {
+        if (sizeof(Size) > 1 && fromMain) {
+            InterruptGuard guard;
+            return index;
+        }
+        return index;
+    }
+
+    /**
+     * @brief 他方のコンテキストと共有するインデックスに書き込む
+     *
+     * @param index 書き込み先のインデックス
+     * @param value 書き込む値
+     * @param fromMain メインループ側から呼び出すか
+     * @note 直前までのメモリアクセスを書き込みより前に確定させます。
+     *       メインループ側で1バイトを超えるインデックスに書き込む場合のみ、その書き込みの間だけ割り込みを禁止します。
+     */
+    template <typename Size>
+    static void store(volatile Size& index, const Size& value, const bool fromMain) {
+        internal::compilerBarrier();
+        if (sizeof(Size) > 1 && fromMain) {
+            InterruptGuard guard;
+            index = value;
+            return;
+        }
+        index = value;
+    }
+};
+
+/**
+ * @brief 割り込みハンドラが追加し、メインループが取り出す
+ */
+using InterruptToMain = InterruptSafe<true>;
+
+/**
+ * @brief メインループが追加し、割り込みハンドラが取り出す
+ */
+using MainToInterrupt = InterruptSafe<false>;
+
+namespace internal {
+
+/**
+ * @brief トリプルバッファの共有状態を交換する (割り込みハンドラとメインループの間)
+ *
+ * @tparam ProducerIsInterrupt 追加する側が割り込みハンドラか
+ * @note 共有状態は1バイトのため、読み出しは1命令で完了します。
+ *       交換は読み出しと書き込みの二命令になるため、メインループ側から行う場合のみ、その間だけ割り込みを禁止します。
+ */
+template <bool ProducerIsInterrupt>
+struct TripleBufferSync<InterruptSafe<ProducerIsInterrupt>> {
+    using State = volatile uint8_t;
+
+    static uint8_t exchange(volatile uint8_t& state, const uint8_t value, const bool fromMain) {
+        internal::compilerBarrier();
+        uint8_t previous = 0;
+        if (fromMain) {
+            InterruptGuard guard;
+            previous = state;
+            state = value;
+        } else {
+            previous = state;
+            state = value;
+        }
+        internal::compilerBarrier();
+        return previous;
+    }
+
+    static uint8_t exchangeFromProducer(volatile uint8_t& state, const uint8_t value) {
+        return exchange(state, value, !ProducerIsInterrupt);
+    }
+
+    static uint8_t exchangeFromConsumer(volatile uint8_t& state, const uint8_t value) {
+        return exchange(state, value, ProducerIsInterrupt);
+    }
+
+    static uint8_t loadFromConsumer(const volatile uint8_t& state) {
+        return state;
+    }
+};
+
+}  // namespace internal
+
+/**
+ * @brief 割り込みハンドラと共有するキュー
+ *
+ * @tparam Element
+ * @tparam Size インデックスの型 (`uint8_t` なら割り込み禁止区間は一切生じません)
+ * @tparam ProducerIsInterrupt 追加する側が割り込みハンドラか
+ * @tparam Indexing 添字ポリシー
+ *
+ * @note データ数を持たず、容量で丸めずに増え続けるhead/tailの差から求めます。
+ *       headは取り出し側、tailは追加側だけが書き換えるため、読み書きの競合は相手のインデックスの読み出しに限られます。
+ */
+template <typename Element, typename Size, bool ProducerIsInterrupt, typename Indexing>
+class Queue<Element, Size, InterruptSafe<ProducerIsInterrupt>, Indexing> {
+   private:
+    using Policy = InterruptSafe<ProducerIsInterrupt>;
+
+    /**
+     * @brief 内部データ管理領域
+     */
+    Element* const internalData;
+
+    /**
+     * @brief 内部データ長さ
+     */
+    Size internalDataSize;
+
+    /**
+     * @brief キュー先頭 (取り出し側が書き換える)
+     */
+    volatile Size head = 0;
+
+    /**
+     * @brief キュー末尾 (追加側が書き換える)
+     */
+    volatile Size tail = 0;
+
+   public:
+    /**
+     * @brief 内部データを扱う領域とそのサイズを指定してキューを初期化
+     *
+     * @param data 内部データ保管用領域
+     * @param dataSize 領域サイズ
+     * @note 領域サイズは2の冪乗であるべきです。それ以外の値を指定した場合、2の冪数のうち領域のサイズを下回らない最大のものが選択されます(15 -> 8, 34 -> 32).
+     *       `ExactCapacity` を指定した場合、データ数を持たずにインデックスを容量の2倍の範囲で巡回させるため、容量はSizeの最大値の半分までとなります(`uint8_t` なら127)。
+     */
+    constexpr Queue(Element* const data, const Size& dataSize);
+
+    Queue(const Queue&) = delete;
+    Queue& operator=(const Queue&) = delete;
+
+    ~Queue() = default;
+
+    /**
+     * @brief キューにデータを追加 (追加側のコンテキストから呼び出す)
+     *
+     * @param data 追加するデータ
+     * @return OperationResult 操作結果
+     */
+    OperationResult enqueue(const Element& data);
+
+    /**
+     * @brief キューからデータを取り出し (取り出し側のコンテキストから呼び出す)
+     *
+     * @param data 取り出したデータの格納先
+     * @return OperationResult 操作結果
+     */
+    OperationResult dequeue(Element* const data);
+
+    /**
+     * @brief キューの先頭から最大maxItems個のデータを、取り出さずにその場でコールバックへ渡してから読み捨てる (取り出し側のコンテキストから呼び出す)
+     *
+     * @tparam Callback `void(Element&)` として呼び出せる関数オブジェクト
+     * @param maxItems 処理するデータの最大数
+     * @param callback 各データに対して呼び出すコールバック
+     * @return Size 処理したデータの数
+     *
+     * @note 処理できる範囲を最初に一度だけ確定し、先頭の位置は最後に一度だけ更新します。
+     *       追加側のインデックスの読み出し・先頭の公開に伴う割り込み禁止区間も、まとめて一度ずつになります。
+     * @note コールバックの中からこのキューの取り出し操作を呼び出してはいけません。
+     */
+    template <typename Callback>
+    Size consume(const Size& maxItems, Callback callback);
+
+    /**
+     * @brief キュー内の全てのデータを、取り出さずにその場でコールバックへ渡してから読み捨てる (取り出し側のコンテキストから呼び出す)
+     *
+     * @tparam Callback `void(Element&)` として呼び出せる関数オブジェクト
+     * @param callback 各データに対して呼び出すコールバック
+     * @return Size 処理したデータの数
+     */
+    template <typename Callback>
+    Size consumeAll(Callback callback) {
+        return consume(internalDataSize, callback);
+    }
+
+    /**
+     * @brief キューの全体長を返す
+     *
+     * @return Size キュー長
+     */
+    Size capacity() const {
+        return internalDataSize;
+    }
+
+    /**
+     * @brief 現在キュー内にあるデータ数を返す
+     *
+     * @return Size キュー内に存在するデータの数
+     * @note 他方のコンテキストが操作している間は、呼び出した時点での近似値となります。
+     */
+    Size amount() const {
+        const Size currentHead = Policy::load(head, true);
+        return Indexing::distance(Policy::load(tail, true), currentHead, internalDataSize);
+    }
+
+    /**
+     * @brief キューに値を追加できるか
+     *
+     * @return bool
+     */
+    bool hasSpace() const {
+        return amount() < internalDataSize;
+    }
+
+    /**
+     * @brief キューが空かどうか
+     *
+     * @return bool
+     */
+    bool isEmpty() const {
+        return amount() == 0;
+    }
+};
+
+template <typename Element, typename Size, bool ProducerIsInterrupt, typename Indexing>
+constexpr Queue<Element, Size, InterruptSafe<ProducerIsInterrupt>, Indexing>::Queue(Element* const data, const Size& dataSize)
+    : internalData(data), internalDataSize(Indexing::freeRunningCapacityOf(dataSize)){};
+
+template <typename Element, typename Size, bool ProducerIsInterrupt, typename Indexing>
+OperationResult Queue<Element, Size, InterruptSafe<ProducerIsInterrupt>, Indexing>::enqueue(const Element& data) {
+    const bool fromMain = !ProducerIsInterrupt;
+    const Size currentTail = tail;
+
+    // 満杯なら戻る
+    if (Indexing::distance(currentTail, Policy::load(head, fromMain), internalDataSize) >= internalDataSize) {
+        return OperationResult::Overflow;
+    }
+
+    // 書き込んでからtailを公開する
+    *(internalData + Indexing::slotOf(currentTail, internalDataSize)) = data;
+    Policy::store(tail, Indexing::step(currentTail, static_cast<Size>(1), internalDataSize), fromMain);
+
+    return OperationResult::Success;
+}
+
+template <typename Element, typename Size, bool ProducerIsInterrupt, typename Indexing>
+OperationResult Queue<Element, Size, InterruptSafe<ProducerIsInterrupt>, Indexing>::dequeue(Element* const data) {
+    const bool fromMain = ProducerIsInterrupt;
+    const Size currentHead = head;
+
+    // キューが空なら戻る
+    if (Policy::load(tail, fromMain) == currentHead) {
+        return OperationResult::Empty;
+    }
+
+    // 読み出してからheadを公開する
+    internal::compilerBarrier();
+    *data = *(internalData + Indexing::slotOf(currentHead, internalDataSize));
+    Policy::store(head, Indexing::step(currentHead, static_cast<Size>(1), internalDataSize), fromMain);
+
+    return OperationResult::Success;
+}
+
+template <typename Element, typename Size, bool ProducerIsInterrupt, typename Indexing>
+template <typename Callback>
+Size Queue<Element, Size, InterruptSafe<ProducerIsInterrupt>, Indexing>::consume(const Size& maxItems, Callback callback) {
+    const bool fromMain = ProducerIsInterrupt;
+    const Size currentHead = head;
+
+    // 処理できる範囲を一度だけ確定する
+    const Size available = Indexing::distance(Policy::load(tail, fromMain), currentHead, internalDataSize);
+    const Size length = available < maxItems ? available : maxItems;
+    if (length == 0) {
+        return 0;
+    }
+
+    // 全て処理してからheadを一度だけ公開する
+    internal::compilerBarrier();
+    Size position = Indexing::slotOf(currentHead, internalDataSize);
+    for (Size i = 0; i < length; i++) {
+        callback(*(internalData + position));
+        position = Indexing::advance(position, static_cast<Size>(1), internalDataSize);
+    }
+    Policy::store(head, Indexing::step(currentHead, length, internalDataSize), fromMain);
+
+    return length;
+}
+
+/**
+ * @brief 割り込みハンドラと共有するリングバッファ
+ *
+ * @tparam Element
+ * @tparam Size インデックスの型
+ * @tparam ProducerIsInterrupt 追加する側が割り込みハンドラか
+ * @tparam Indexing 添字ポリシー
+ *
+ * @note 満杯時の上書きでは追加側が先頭を進めるため、その部分だけは割り込み禁止区間で保護します。
+ *       メインループが追加する場合は上書き時のheadの更新だけを、割り込みハンドラが追加する場合はメインループ側のpop全体(要素1つのコピーを含む)を保護します。
+ *       メインループが追加する場合、上書きが起こらない範囲ではQueueと同じく、1バイトのインデックスであれば割り込み禁止区間は生じません。
+ */
+template <typename Element, typename Size, bool ProducerIsInterrupt, typename Indexing>
+class Buffer<Element, Size, InterruptSafe<ProducerIsInterrupt>, Indexing> {
+   private:
+    using Policy = InterruptSafe<ProducerIsInterrupt>;
+
+    /**
+     * @brief 内部データ管理領域
+     */
+    Element* const internalData;
+
+    /**
+     * @brief 内部データ長さ
+     */
+    Size internalDataSize;
+
+    /**
+     * @brief バッファ先頭 (取り出し側と、上書き時の追加側が書き換える)
+     */
+    volatile Size head = 0;
+
+    /**
+     * @brief バッファ末尾 (追加側が書き換える)
+     */
+    volatile Size tail = 0;
+
+    /**
+     * @brief headを一つ進める
+     *
+     * @param data 取り出したデータの格納先 (nullptrの場合は読み捨てる)
+     * @return OperationResult 操作結果
+     * @note 割り込みハンドラの中か、割り込み禁止区間の中から呼び出します。
+     */
+    OperationResult advanceHead(Element* const data);
+
+   public:
+    /**
+     * @brief 内部データを扱う領域とそのサイズを指定してバッファを初期化
+     *
+     * @param data 内部データ保管用領域
+     * @param dataSize 領域サイズ
+     * @note 領域サイズは2の冪乗であるべきです。それ以外の値を指定した場合、2の冪数のうち領域のサイズを下回らない最大のものが選択されます(15 -> 8, 34 -> 32).
+     *       `ExactCapacity` を指定した場合、データ数を持たずにインデックスを容量の2倍の範囲で巡回させるため、容量はSizeの最大値の半分までとなります(`uint8_t` なら127)。
+     */
+    constexpr Buffer(Element* const data, const Size& dataSize);
+
+    Buffer(const Buffer&) = delete;
+    Buffer& operator=(const Buffer&) = delete;
+
+    ~Buffer() = default;
+
+    /**
+     * @brief バッファの末尾にデータを追加 (追加側のコンテキストから呼び出す)
+     *
+     * @param data 追加するデータ
+     * @return OperationResult 操作結果
+     * @note バッファがいっぱいの場合は、先頭のデータが捨てられます。
+     */
+    OperationResult append(const Element& data);
+
+    /**
+     * @brief バッファの先頭からデータを取り出し (取り出し側のコンテキストから呼び出す)
+     *
+     * @param data 取り出したデータの格納先 (nullptrの場合は読み捨てる)
+     * @return OperationResult 操作結果
+     */
+    OperationResult pop(Element* const data);
+
+    /**
+     * @brief バッファの全体長を返す
+     *
+     * @return Size バッファ長
+     */
+    Size capacity() const {
+        return internalDataSize;
+    }
+
+    /**
+     * @brief 現在バッファ内にあるデータ数を返す
+     *
+     * @return Size バッファ内に存在するデータの数
+     * @note 他方のコンテキストが操作している間は、呼び出した時点での近似値となります。
+     */
+    Size amount() const {
+        const Size currentHead = Policy::load(head, true);
+        return Indexing::distance(Policy::load(tail, true), currentHead, internalDataSize);
+    }
+
+    /**
+     * @brief バッファに値を追加できるか
+     *
+     * @return bool
+     */
+    bool hasSpace() const {
+        return amount() < internalDataSize;
+    }
+
+    /**
+     * @brief バッファが空かどうか
+     *
+     * @return bool
+     */
+    bool isEmpty() const {
+        return amount() == 0;
+    }
+};
+
+template <typename Element, typename Size, bool ProducerIsInterrupt, typename Indexing>
+constexpr Buffer<Element, Size, InterruptSafe<ProducerIsInterrupt>, Indexing>::Buffer(Element* const data, const Size& dataSize)
+    : internalData(data), internalDataSize(Indexing::freeRunningCapacityOf(dataSize)){};
+
+template <typename Element, typename Size, bool ProducerIsInterrupt, typename Indexing>
+OperationResult Buffer<Element, Size, InterruptSafe<ProducerIsInterrupt>, Indexing>::advanceHead(Element* const data) {
+    const Size currentHead = head;
+
+    // バッファが空なら戻る
+    if (tail == currentHead) {
+        return OperationResult::Empty;
+    }
+
+    // 読み出して渡す。nullptrなら何もしないでheadを進める。
+    internal::compilerBarrier();
+    if (data != nullptr) {
+        *data = *(internalData + Indexing::slotOf(currentHead, internalDataSize));
+    }
+    Policy::store(head, Indexing::step(currentHead, static_cast<Size>(1), internalDataSize), false);
+
+    return OperationResult::Success;
+}
+
+template <typename Element, typename Size, bool ProducerIsInterrupt, typename Indexing>
+OperationResult Buffer<Element, Size, InterruptSafe<ProducerIsInterrupt>, Indexing>::append(const Element& data) {
+    // サイズ0のバッファに値を追加することはできない
+    if (internalDataSize == 0) {
+        return OperationResult::Overflow;
+    }
+
+    const bool fromMain = !ProducerIsInterrupt;
+    const Size currentTail = tail;
+
+    // バッファがいっぱいなら、要素を一つ読み捨てる
+    // 割り込みハンドラからであれば取り出し側に割り込まれることはなく、メインループからであれば禁止区間内で行う
+    if (Indexing::distance(currentTail, Policy::load(head, fromMain), internalDataSize) >= internalDataSize) {
+        if (ProducerIsInterrupt) {
+            head = Indexing::step(static_cast<Size>(head), static_cast<Size>(1), internalDataSize);
+        } else {
+            InterruptGuard guard;
+            const Size currentHead = head;
+            if (Indexing::distance(currentTail, currentHead, internalDataSize) >= internalDataSize) {
+                head = Indexing::step(currentHead, static_cast<Size>(1), internalDataSize);
+            }
+        }
+    }
+
+    // 書き込んでからtailを公開する
+    *(internalData + Indexing::slotOf(currentTail, internalDataSize)) = data;
+    Policy::store(tail, Indexing::step(currentTail, static_cast<Size>(1), internalDataSize), fromMain);
+
+    return OperationResult::Success;
+}
+
+template <typename Element, typename Size, bool ProducerIsInterrupt, typename Indexing>
+OperationResult Buffer<Element, Size, InterruptSafe<ProducerIsInterrupt>, Indexing>::pop(Element* const data) {
+    // 割り込みハンドラが上書きしうる場合は、読み出しとheadの更新を一度に行う
+    if (ProducerIsInterrupt) {
+        InterruptGuard guard;
+        return advanceHead(data);
+    }
+    return advanceHead(data);
+}
+
+}  // namespace collection2
+
+#endif
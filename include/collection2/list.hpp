@@ -8,6 +8,7 @@
 #include <stddef.h>
 
 #include "common.hpp"
+#include "pool.hpp"
 
 namespace collection2 {
 
@@ -19,9 +20,6 @@ namespace collection2 {
  */
 template <typename Element, typename Size = size_t>
 struct Node {
-    // 有効なノードか
-    bool isEnabled = false;
-
     // 次の要素へのポインタ
     Node* next = nullptr;
 
@@ -29,26 +27,38 @@ struct Node {
     Node* previous = nullptr;
 
     // ノードが持つ要素
-    Element element;
+    Element element = Element();
+
+    Node() = default;
+
+    /**
+     * @brief 値と前後のノードを指定してノードを構築する
+     *
+     * @param value ノードが持つ要素
+     * @param nextNode 次の要素
+     * @param previousNode 前の要素
+     */
+    constexpr Node(const Element& value, Node* nextNode = nullptr, Node* previousNode = nullptr)
+        : next(nextNode), previous(previousNode), element(value) {}
 };
 
 /**
  * @brief リスト
  *
  * @tparam Element 扱う要素の型
+ * @tparam Size 要素数の型
+ * @tparam Policy ノードプールの並行性ポリシー (既定では専用のプールを持ちます。他のリストやツリーとプールを共有する場合は `SharedPool` を、
+ *                複数のスレッドで共有するプールを使う場合は `concurrent_pool.hpp` の `LockFree` を指定します)
  */
-template <typename Element, typename Size = size_t>
+template <typename Element, typename Size = size_t, typename Policy = SingleContext>
 class List {
    private:
-    /**
-     * @brief 内部データ管理領域
-     */
-    Node<Element>* const internalData;
+    using NodePool = internal::NodePoolHolder<Node<Element, Size>, Size, Policy>;
 
     /**
-     * @brief 内部データ長さ
+     * @brief ノードの確保・返却に使うプール (共有プールを使う場合は、そのポインタのみを持つ)
      */
-    Size internalDataSize;
+    NodePool nodePool;
 
     /**
      * @brief リスト先頭
@@ -65,26 +75,38 @@ class List {
      */
     Size count = 0;
 
-    /**
-     * @brief 新しいノードへのポインタを返す
-     *
-     * @return Node<Element>* データを追加できる位置のポインタ。内部データ領域がいっぱいの場合はnullptrが返ります。
-     */
-    Node<Element, Size>* getNewNode() const;
-
    public:
     /**
      * @brief 内部データを扱う領域とそのサイズを指定してリストを初期化
      *
      * @param data 内部データ保管用領域
      * @param dataSize 領域サイズ
+     * @note 既定のポリシー (`SingleContext`) でのみ使用できます。
+     */
+    constexpr List(Node<Element, Size>* const data, const Size& dataSize);
+
+    /**
+     * @brief 他のリストやツリーと共有するノードプールを指定してリストを初期化
+     *
+     * @param pool ノードプール
+     * @note ノードは必要になった時点でプールから確保され、削除した時点でプールに返却されます。
+     *       プールはリストより長く存続する必要があります。
+     * @note `SharedPool` または `LockFree` ポリシーでのみ使用できます。
      */
-    List(Node<Element, Size>* const data, const Size& dataSize);
+    explicit constexpr List(typename NodePool::PoolType& pool);
 
     List(const List&) = delete;
     List& operator=(const List&) = delete;
 
-    ~List() = default;
+    /**
+     * @brief リストを破棄する
+     * @note 共有プールを使用している場合は、残っているノードをプールに返却します。
+     */
+    ~List() {
+        if (!NodePool::owning) {
+            clear();
+        }
+    }
 
     /**
      * @brief リストの末尾にデータを追加
@@ -130,12 +152,58 @@ class List {
      */
     Element* get(const Size& index);
 
+    /**
+     * @brief 全ての要素を削除する
+     */
+    void clear();
+
+    /**
+     * @brief リストを安定ソートする
+     *
+     * @tparam Compare 比較関数の型
+     * @param compare 比較関数 `bool(const Element& lhs, const Element& rhs)`。lhsをrhsより前に置くべきときにtrueを返す
+     *
+     * @note ボトムアップのマージソートにより、ノードの接続のみを組み替えます。要素のコピーや追加の領域は必要ありません。
+     */
+    template <typename Compare>
+    void sort(Compare compare);
+
+    /**
+     * @brief `operator<` の昇順でリストを安定ソートする
+     */
+    void sort() {
+        sort([](const Element& lhs, const Element& rhs) { return lhs < rhs; });
+    }
+
+    /**
+     * @brief 整列済みのリストに、順序を保つ位置へデータを追加
+     *
+     * @tparam Compare 比較関数の型
+     * @param element 追加するデータ
+     * @param compare 比較関数 (sortと同じもの)
+     * @return OperationResult 操作結果
+     *
+     * @note 等しい要素が既にある場合、それらの後ろに追加されます。
+     */
+    template <typename Compare>
+    OperationResult insertSorted(const Element& element, Compare compare);
+
+    /**
+     * @brief `operator<` の昇順に整列済みのリストに、順序を保つ位置へデータを追加
+     *
+     * @param element 追加するデータ
+     * @return OperationResult 操作結果
+     */
+    OperationResult insertSorted(const Element& element) {
+        return insertSorted(element, [](const Element& lhs, const Element& rhs) { return lhs < rhs; });
+    }
+
     /**
      * @brief リスト先頭へのポインタを取得
      *
      * @return Element* リスト先頭へのポインタ
      */
-    Node<Element>* head() const {
+    Node<Element, Size>* head() const {
         return headPtr;
     }
 
@@ -144,7 +212,7 @@ class List {
      *
      * @return Element* リスト末尾へのポインタ
      */
-    Node<Element>* tail() const {
+    Node<Element, Size>* tail() const {
         return tailPtr;
     }
 
@@ -152,9 +220,10 @@ class List {
      * @brief リストの全体長を返す
      *
      * @return buffer_size_t リスト長
+     * @note 共有プールを使用している場合は、プール全体の大きさを返します。
      */
     Size capacity() const {
-        return internalDataSize;
+        return nodePool->capacity();
     }
 
     /**
@@ -167,29 +236,36 @@ class List {
     }
 };
 
-template <typename Element, typename Size>
-List<Element, Size>::List(Node<Element, Size>* const data, const Size& dataSize) : internalData(data), internalDataSize(dataSize){};
+template <typename Element, typename Size, typename Policy>
+constexpr List<Element, Size, Policy>::List(Node<Element, Size>* const data, const Size& dataSize)
+    : nodePool(data, dataSize) {
+    static_assert(NodePool::owning, "collection2::List: storage constructor requires the SingleContext policy; pass a pool instead");
+}
 
-template <typename Element, typename Size>
-Node<Element, Size>* List<Element, Size>::getNewNode() const {
-    for (Size i = 0; i < internalDataSize; i++) {
-        if (internalData[i].isEnabled) {
-            continue;
-        }
+template <typename Element, typename Size, typename Policy>
+constexpr List<Element, Size, Policy>::List(typename NodePool::PoolType& pool)
+    : nodePool(pool) {
+    static_assert(!NodePool::owning, "collection2::List: a shared pool requires the SharedPool or LockFree policy");
+}
 
-        // 見つかったらノードを初期化して返す
-        internalData[i].isEnabled = true;
-        internalData[i].next = nullptr;
-        internalData[i].previous = nullptr;
-        return &(internalData[i]);
+template <typename Element, typename Size, typename Policy>
+void List<Element, Size, Policy>::clear() {
+    // 先頭から順に返却する
+    auto* node = headPtr;
+    while (node != nullptr) {
+        auto* next = node->next;
+        nodePool->release(node);
+        node = next;
     }
-    return nullptr;
+    headPtr = nullptr;
+    tailPtr = nullptr;
+    count = 0;
 }
 
-template <typename Element, typename Size>
-OperationResult List<Element, Size>::append(const Element& element) {
+template <typename Element, typename Size, typename Policy>
+OperationResult List<Element, Size, Policy>::append(const Element& element) {
     // 新しいノードを取得し、値を設定
-    auto* newNode = getNewNode();
+    auto* newNode = nodePool->acquire();
     if (newNode == nullptr) {
         return OperationResult::Overflow;
     }
@@ -212,10 +288,10 @@ OperationResult List<Element, Size>::append(const Element& element) {
     return OperationResult::Success;
 }
 
-template <typename Element, typename Size>
-OperationResult List<Element, Size>::insert(const Size& index, const Element& element) {
+template <typename Element, typename Size, typename Policy>
+OperationResult List<Element, Size, Policy>::insert(const Size& index, const Element& element) {
     // 新しいノードを取得し、値を設定
-    auto* newNode = getNewNode();
+    auto* newNode = nodePool->acquire();
     if (newNode == nullptr) {
         return OperationResult::Overflow;
     }
@@ -232,6 +308,7 @@ OperationResult List<Element, Size>::insert(const Size& index, const Element& el
     // 先頭への追加の場合、現在のheadが新しいノードのnextとなる
     if (index == 0) {
         newNode->next = headPtr;
+        headPtr->previous = newNode;
         headPtr = newNode;
         count++;
         return OperationResult::Success;
@@ -263,8 +340,8 @@ OperationResult List<Element, Size>::insert(const Size& index, const Element& el
     return OperationResult::Success;
 }
 
-template <typename Element, typename Size>
-OperationResult List<Element, Size>::pop(Element* const element) {
+template <typename Element, typename Size, typename Policy>
+OperationResult List<Element, Size, Policy>::pop(Element* const element) {
     if (tailPtr == nullptr) {
         return OperationResult::Empty;
     }
@@ -282,20 +359,20 @@ OperationResult List<Element, Size>::pop(Element* const element) {
     if (tailPtr == nullptr) {
         // tailがnullになった=リストが空になった
         headPtr = nullptr;
+    } else {
+        tailPtr->next = nullptr;
     }
 
-    // ノードを無効化する
-    targetNode->isEnabled = false;
-    targetNode->next = nullptr;
-    targetNode->previous = nullptr;
+    // ノードをプールに返却
+    nodePool->release(targetNode);
 
     count--;
 
     return OperationResult::Success;
 }
 
-template <typename Element, typename Size>
-OperationResult List<Element, Size>::remove(const Size& index, Element* const element) {
+template <typename Element, typename Size, typename Policy>
+OperationResult List<Element, Size, Policy>::remove(const Size& index, Element* const element) {
     if (headPtr == nullptr) {
         return OperationResult::Empty;
     }
@@ -308,6 +385,8 @@ OperationResult List<Element, Size>::remove(const Size& index, Element* const el
         if (headPtr == nullptr) {
             // headがnullになった=リストが空になった
             tailPtr = nullptr;
+        } else {
+            headPtr->previous = nullptr;
         }
 
         // ノードに格納されている情報を渡す
@@ -315,10 +394,8 @@ OperationResult List<Element, Size>::remove(const Size& index, Element* const el
             *element = targetNode->element;
         }
 
-        // 要素を無効化
-        targetNode->isEnabled = false;
-        targetNode->next = nullptr;
-        targetNode->previous = nullptr;
+        // ノードをプールに返却
+        nodePool->release(targetNode);
 
         count--;
 
@@ -348,18 +425,16 @@ OperationResult List<Element, Size>::remove(const Size& index, Element* const el
     }
     targetNode->previous->next = targetNode->next;
 
-    // ノードを無効化
-    targetNode->isEnabled = false;
-    targetNode->next = nullptr;
-    targetNode->previous = nullptr;
+    // ノードをプールに返却
+    nodePool->release(targetNode);
 
     count--;
 
     return OperationResult::Success;
 }
 
-template <typename Element, typename Size>
-Element* List<Element, Size>::get(const Size& index) {
+template <typename Element, typename Size, typename Policy>
+Element* List<Element, Size, Policy>::get(const Size& index) {
     if (headPtr == nullptr) {
         return nullptr;
     }
@@ -380,6 +455,108 @@ Element* List<Element, Size>::get(const Size& index) {
     return &(node->element);
 }
 
+template <typename Element, typename Size, typename Policy>
+template <typename Compare>
+void List<Element, Size, Policy>::sort(Compare compare) {
+    if (headPtr == nullptr) {
+        return;
+    }
+
+    // 長さwidthの整列済み部分列を隣同士で併合していく
+    Size width = 1;
+    while (true) {
+        auto* lhs = headPtr;
+        Node<Element, Size>* merged = nullptr;
+        Size mergeCount = 0;
+        headPtr = nullptr;
+
+        while (lhs != nullptr) {
+            mergeCount++;
+
+            // lhsから最大width個進んだ位置を右側の部分列の先頭とする
+            auto* rhs = lhs;
+            Size lhsSize = 0;
+            while (rhs != nullptr && lhsSize < width) {
+                rhs = rhs->next;
+                lhsSize++;
+            }
+            Size rhsSize = width;
+
+            // 2つの部分列を併合する 等しい場合は左側を優先し、安定性を保つ
+            while (lhsSize > 0 || (rhsSize > 0 && rhs != nullptr)) {
+                Node<Element, Size>* node = nullptr;
+                if (lhsSize == 0) {
+                    node = rhs;
+                    rhs = rhs->next;
+                    rhsSize--;
+                } else if (rhsSize == 0 || rhs == nullptr || !compare(rhs->element, lhs->element)) {
+                    node = lhs;
+                    lhs = lhs->next;
+                    lhsSize--;
+                } else {
+                    node = rhs;
+                    rhs = rhs->next;
+                    rhsSize--;
+                }
+
+                // 併合結果の末尾に繋ぐ
+                if (merged == nullptr) {
+                    headPtr = node;
+                } else {
+                    merged->next = node;
+                }
+                node->previous = merged;
+                merged = node;
+            }
+
+            lhs = rhs;
+        }
+        merged->next = nullptr;
+
+        // 併合が1回で済んだ=全体が整列済み
+        if (mergeCount <= 1) {
+            tailPtr = merged;
+            return;
+        }
+        width *= 2;
+    }
+}
+
+template <typename Element, typename Size, typename Policy>
+template <typename Compare>
+OperationResult List<Element, Size, Policy>::insertSorted(const Element& element, Compare compare) {
+    // 新しいノードを取得し、値を設定
+    auto* newNode = nodePool->acquire();
+    if (newNode == nullptr) {
+        return OperationResult::Overflow;
+    }
+    newNode->element = element;
+
+    // elementより後ろに置くべき最初のノードを探す
+    auto* nextNode = headPtr;
+    while (nextNode != nullptr && !compare(element, nextNode->element)) {
+        nextNode = nextNode->next;
+    }
+
+    // nextNodeの直前に接続
+    auto* previousNode = (nextNode == nullptr) ? tailPtr : nextNode->previous;
+    newNode->previous = previousNode;
+    newNode->next = nextNode;
+    if (previousNode == nullptr) {
+        headPtr = newNode;
+    } else {
+        previousNode->next = newNode;
+    }
+    if (nextNode == nullptr) {
+        tailPtr = newNode;
+    } else {
+        nextNode->previous = newNode;
+    }
+    count++;
+
+    return OperationResult::Success;
+}
+
 }  // namespace collection2
 
 #endif
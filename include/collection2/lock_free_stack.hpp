@@ -0,0 +1,290 @@
+//
+// ロックフリースタック (ホスト環境のみ)
+//
+
+#ifndef COLLECTION2_LOCK_FREE_STACK_H
+#define COLLECTION2_LOCK_FREE_STACK_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+
+#include "common.hpp"
+
+namespace collection2 {
+
+namespace internal {
+
+/**
+ * @brief タグ付きインデックスで表した単方向リストの先頭 (Treiber stack)
+ *
+ * @note 先頭のインデックス(下位32ビット)と、先頭を書き換えるたびに増やすタグ(上位32ビット)を一つの64ビットのアトミック変数にまとめます。
+ *       取り出しの途中で他のスレッドが同じノードを取り出して戻しても、タグが異なるため比較交換は失敗します(ABA問題の回避)。
+ * @note ノードは呼び出し側の領域にあり解放されないため、ハザードポインタなどの遅延解放の仕組みは不要です。
+ * @note 各ノードの次のノードへのリンクは、`load(index)` と `store(index, next)` を持つオブジェクトを介して読み書きします。
+ */
+class TaggedIndexHead {
+   private:
+    /**
+     * @brief 先頭のインデックスとタグ
+     */
+    std::atomic<uint64_t> word;
+
+    /**
+     * @brief インデックスとタグを一つの値にまとめる
+     */
+    static constexpr uint64_t pack(const uint32_t index, const uint32_t tag) {
+        return static_cast<uint64_t>(tag) << 32 | index;
+    }
+
+    /**
+     * @brief まとめた値からインデックスを取り出す
+     */
+    static constexpr uint32_t indexOf(const uint64_t value) {
+        return static_cast<uint32_t>(value);
+    }
+
+    /**
+     * @brief まとめた値からタグを取り出す
+     */
+    static constexpr uint32_t tagOf(const uint64_t value) {
+        return static_cast<uint32_t>(value >> 32);
+    }
+
+   public:
+    /**
+     * @brief リストの終端を表すインデックス
+     */
+    static constexpr uint32_t nullIndex = 0xFFFFFFFF;
+
+    /**
+     * @brief 先頭のノードを指定してリストを初期化
+     *
+     * @param index 先頭のノード (空ならnullIndex)
+     */
+    explicit TaggedIndexHead(const uint32_t index = nullIndex) : word(pack(index, 0)) {}
+
+    TaggedIndexHead(const TaggedIndexHead&) = delete;
+    TaggedIndexHead& operator=(const TaggedIndexHead&) = delete;
+
+    /**
+     * @brief 先頭のノードを取り外す
+     *
+     * @param links ノードのリンクを読み書きするオブジェクト
+     * @return uint32_t 取り外したノード (空ならnullIndex)
+     * @note 成功した場合、そのノードを最後に繋いだスレッドの書き込みが見えることを保証します。
+     */
+    template <typename Links>
+    uint32_t pop(const Links& links) {
+        uint64_t current = word.load(std::memory_order_acquire);
+        while (true) {
+            const uint32_t index = indexOf(current);
+            if (index == nullIndex) {
+                return nullIndex;
+            }
+
+            // 他のスレッドに取り外されていればリンクは古い値になりうるが、タグが変わっているので比較交換は失敗する
+            const uint64_t desired = pack(links.load(index), tagOf(current) + 1);
+            if (word.compare_exchange_weak(current, desired, std::memory_order_acquire, std::memory_order_acquire)) {
+                return index;
+            }
+        }
+    }
+
+    /**
+     * @brief ノードを先頭に繋ぐ
+     *
+     * @param links ノードのリンクを読み書きするオブジェクト
+     * @param index 繋ぐノード
+     * @note 呼び出し前のノードへの書き込みは、このノードを取り外したスレッドから見えるようになります。
+     */
+    template <typename Links>
+    void push(const Links& links, const uint32_t index) {
+        uint64_t current = word.load(std::memory_order_relaxed);
+        do {
+            links.store(index, indexOf(current));
+        } while (!word.compare_exchange_weak(current, pack(index, tagOf(current) + 1), std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    /**
+     * @brief リストが空かどうか
+     *
+     * @return bool
+     * @note 他のスレッドが操作している間は、呼び出した時点での近似値となります。
+     */
+    bool isEmpty() const {
+        return indexOf(word.load(std::memory_order_acquire)) == nullIndex;
+    }
+};
+
+}  // namespace internal
+
+/**
+ * @brief ロックフリースタックの各ノードを表す構造体
+ *
+ * @tparam Element 要素の型
+ */
+template <typename Element>
+struct LockFreeStackNode {
+    // 次のノードのインデックス (他のスレッドが取り外しの途中で読むため、アトミックに扱う)
+    std::atomic<uint32_t> next;
+
+    // 要素
+    Element element = Element();
+};
+
+/**
+ * @brief 複数のスレッドから同時に操作できる、固定長のロックフリースタック
+ *
+ * @tparam Element 要素の型
+ * @tparam Size 要素数の型
+ *
+ * @note 呼び出し側が用意したノードの配列を、要素を積んだスタックと空きノードのリストの2本のTreiber stackで管理します。
+ *       どちらの先頭もインデックスとタグを一つの64ビットのアトミック変数にまとめているため、ABA問題は起こらず、ヒープやハザードポインタも使用しません。
+ * @note 扱えるノードは最大 2^32 - 1 個です。タグは32ビットのため、一つのスレッドが比較交換を試みる間に同じ先頭がちょうど 2^32 回書き換えられない限り、ABA問題は検出されます。
+ * @note 要素数を数えるとそれ自体が競合の原因になるため、 `amount()` は提供しません。
+ */
+template <typename Element, typename Size = size_t>
+class LockFreeStack {
+   private:
+    /**
+     * @brief ノードのリンクを読み書きするオブジェクト
+     */
+    struct NodeLinks {
+        LockFreeStackNode<Element>* const nodes;
+
+        uint32_t load(const uint32_t index) const {
+            return nodes[index].next.load(std::memory_order_relaxed);
+        }
+
+        void store(const uint32_t index, const uint32_t next) const {
+            nodes[index].next.store(next, std::memory_order_relaxed);
+        }
+    };
+
+    /**
+     * @brief ノード管理領域
+     */
+    const NodeLinks links;
+
+    /**
+     * @brief ノード数
+     */
+    Size internalDataSize;
+
+    /**
+     * @brief 要素を積んだスタックの先頭
+     */
+    alignas(COLLECTION2_CACHE_LINE_SIZE) internal::TaggedIndexHead top;
+
+    /**
+     * @brief 空きノードのリストの先頭
+     */
+    alignas(COLLECTION2_CACHE_LINE_SIZE) internal::TaggedIndexHead freeTop;
+
+   public:
+    /**
+     * @brief ノードを扱う領域とそのサイズを指定してスタックを初期化
+     *
+     * @param data ノード保管用領域
+     * @param dataSize 領域サイズ
+     * @note 全てのノードを空きノードのリストに繋ぐため、構築は他のスレッドと共有する前に行う必要があります。
+     */
+    LockFreeStack(LockFreeStackNode<Element>* const data, const Size& dataSize);
+
+    LockFreeStack(const LockFreeStack&) = delete;
+    LockFreeStack& operator=(const LockFreeStack&) = delete;
+
+    ~LockFreeStack() = default;
+
+    /**
+     * @brief スタックにデータを追加 (任意のスレッドから呼び出せる)
+     *
+     * @param data 追加するデータ
+     * @return OperationResult 操作結果
+     */
+    OperationResult push(const Element& data);
+
+    /**
+     * @brief スタックからデータを取り出し (任意のスレッドから呼び出せる)
+     *
+     * @param data 取り出したデータの格納先
+     * @return OperationResult 操作結果
+     */
+    OperationResult pop(Element* const data);
+
+    /**
+     * @brief スタックの全体長を返す
+     *
+     * @return Size スタック長
+     */
+    Size capacity() const {
+        return internalDataSize;
+    }
+
+    /**
+     * @brief スタックに値を追加できるか
+     *
+     * @return bool
+     * @note 他のスレッドが操作している間は、呼び出した時点での近似値となります。
+     */
+    bool hasSpace() const {
+        return !freeTop.isEmpty();
+    }
+
+    /**
+     * @brief スタックが空かどうか
+     *
+     * @return bool
+     * @note 他のスレッドが操作している間は、呼び出した時点での近似値となります。
+     */
+    bool isEmpty() const {
+        return top.isEmpty();
+    }
+};
+
+template <typename Element, typename Size>
+LockFreeStack<Element, Size>::LockFreeStack(LockFreeStackNode<Element>* const data, const Size& dataSize)
+    : links{data},
+      internalDataSize(static_cast<uint64_t>(dataSize) < internal::TaggedIndexHead::nullIndex ? dataSize : static_cast<Size>(internal::TaggedIndexHead::nullIndex)),
+      top(),
+      freeTop(internalDataSize > 0 ? 0 : internal::TaggedIndexHead::nullIndex) {
+    // 全てのノードを先頭から順に空きノードのリストに繋ぐ
+    for (Size i = 0; i < internalDataSize; i++) {
+        links.store(static_cast<uint32_t>(i), i + 1 < internalDataSize ? static_cast<uint32_t>(i + 1) : internal::TaggedIndexHead::nullIndex);
+    }
+}
+
+template <typename Element, typename Size>
+OperationResult LockFreeStack<Element, Size>::push(const Element& data) {
+    // 空きノードを一つ取り外す
+    const uint32_t index = freeTop.pop(links);
+    if (index == internal::TaggedIndexHead::nullIndex) {
+        return OperationResult::Overflow;
+    }
+
+    // 取り外したノードは他のスレッドから触られないので、書き込んでから公開する
+    links.nodes[index].element = data;
+    top.push(links, index);
+
+    return OperationResult::Success;
+}
+
+template <typename Element, typename Size>
+OperationResult LockFreeStack<Element, Size>::pop(Element* const data) {
+    const uint32_t index = top.pop(links);
+    if (index == internal::TaggedIndexHead::nullIndex) {
+        return OperationResult::Empty;
+    }
+
+    // 読み出してから空きノードのリストに戻す
+    *data = links.nodes[index].element;
+    freeTop.push(links, index);
+
+    return OperationResult::Success;
+}
+
+}  // namespace collection2
+
+#endif
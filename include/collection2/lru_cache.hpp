@@ -0,0 +1,454 @@
+//
+// LRUキャッシュ
+//
+
+#ifndef COLLECTION2_LRU_CACHE_H
+#define COLLECTION2_LRU_CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "common.hpp"
+#include "list.hpp"
+#include "pool.hpp"
+
+namespace collection2 {
+
+/**
+ * @brief LRUキャッシュに格納されるキーと値の組
+ *
+ * @tparam Key キーの型
+ * @tparam Value 値の型
+ */
+template <typename Key, typename Value>
+struct LruCacheEntry {
+    // キー
+    Key key = Key();
+
+    // 値
+    Value value = Value();
+};
+
+/**
+ * @brief LRUキャッシュの各エントリを保持するノード (リストのノードをそのまま使用する)
+ */
+template <typename Key, typename Value, typename Size = size_t>
+using LruCacheNode = Node<LruCacheEntry<Key, Value>, Size>;
+
+/**
+ * @brief キーのバイト列から求めるハッシュ関数 (FNV-1a)
+ *
+ * @tparam Key キーの型
+ * @note キーのオブジェクト表現をそのまま使うため、パディングを含む型やポインタで内容を指す型には独自のハッシュ関数を指定してください。
+ */
+template <typename Key>
+struct LruCacheHash {
+    uint32_t operator()(const Key& key) const {
+        const auto* bytes = reinterpret_cast<const unsigned char*>(&key);
+        uint32_t hash = 2166136261UL;
+        for (size_t i = 0; i < sizeof(Key); i++) {
+            hash = (hash ^ bytes[i]) * 16777619UL;
+        }
+        return hash;
+    }
+};
+
+/**
+ * @brief 最も長く使われていないエントリから追い出す、固定容量のキャッシュ
+ *
+ * @tparam Key キーの型 (`==` で比較できる型)
+ * @tparam Value 値の型
+ * @tparam Size 要素数の型
+ * @tparam Hash キーのハッシュ関数 (`uint32_t operator()(const Key&) const` を持つ型)
+ *
+ * @note エントリは使用順に双方向リストでつなぎ、キーからエントリへの索引は開番地法(線形探査)のハッシュ表で管理します。
+ *       そのため、取得・追加・追い出しはいずれも O(1) で行われます(ハッシュ表が十分に空いている場合)。
+ * @note ハッシュ表の大きさはエントリ数の2倍程度を推奨します。
+ */
+template <typename Key, typename Value, typename Size = size_t, typename Hash = LruCacheHash<Key>>
+class LruCache {
+   public:
+    /**
+     * @brief エントリが追い出されるときに呼ばれるコールバック
+     *
+     * @param key 追い出されるエントリのキー
+     * @param value 追い出されるエントリの値
+     * @param context コールバックの登録時に渡した任意のポインタ
+     */
+    using EvictionCallback = void (*)(const Key& key, Value& value, void* context);
+
+   private:
+    /**
+     * @brief ノード保管用領域の先頭 (ハッシュ表からノードの位置を求めるために使う)
+     */
+    LruCacheNode<Key, Value, Size>* const nodes;
+
+    /**
+     * @brief ノードプール
+     */
+    Pool<LruCacheNode<Key, Value, Size>, Size> nodePool;
+
+    /**
+     * @brief ハッシュ表 (ノードの位置+1を格納し、0なら空)
+     */
+    Size* const table;
+
+    /**
+     * @brief ハッシュ表の大きさ
+     */
+    Size tableSize;
+
+    /**
+     * @brief 最も長く使われていないエントリ
+     */
+    LruCacheNode<Key, Value, Size>* headPtr = nullptr;
+
+    /**
+     * @brief 最も最近使われたエントリ
+     */
+    LruCacheNode<Key, Value, Size>* tailPtr = nullptr;
+
+    /**
+     * @brief 格納されているエントリの数
+     */
+    Size count = 0;
+
+    /**
+     * @brief ハッシュ関数
+     */
+    Hash hasher;
+
+    /**
+     * @brief 追い出し時のコールバック
+     */
+    EvictionCallback evictionCallback = nullptr;
+
+    /**
+     * @brief コールバックに渡すポインタ
+     */
+    void* evictionContext = nullptr;
+
+    /**
+     * @brief キーの探索を始めるハッシュ表の位置を返す
+     *
+     * @param key キー
+     * @return Size
+     */
+    Size homeSlot(const Key& key) const {
+        return static_cast<Size>(hasher(key) & (tableSize - 1));
+    }
+
+    /**
+     * @brief キーを持つエントリの位置、またはキーを挿入すべき空きの位置を探す
+     *
+     * @param key キー
+     * @return Size ハッシュ表の位置 (table[位置]が0ならキーは存在しない)
+     */
+    Size findSlot(const Key& key) const;
+
+    /**
+     * @brief ハッシュ表からエントリを削除し、後続のエントリを詰める
+     *
+     * @param slot 削除する位置
+     */
+    void eraseSlot(Size slot);
+
+    /**
+     * @brief ノードを使用順のリストから外す
+     *
+     * @param node 対象のノード
+     */
+    void unlink(LruCacheNode<Key, Value, Size>* const node);
+
+    /**
+     * @brief ノードを使用順のリストの末尾 (最も最近使われた位置) につなぐ
+     *
+     * @param node 対象のノード
+     */
+    void linkTail(LruCacheNode<Key, Value, Size>* const node);
+
+    /**
+     * @brief ハッシュ表の位置にあるエントリを削除する
+     *
+     * @param slot 削除する位置
+     */
+    void removeAt(const Size& slot);
+
+   public:
+    /**
+     * @brief エントリ・ハッシュ表を扱う領域とそのサイズを指定してキャッシュを初期化
+     *
+     * @param data エントリ保管用領域
+     * @param dataSize エントリ領域のサイズ
+     * @param tableData ハッシュ表用領域
+     * @param tableDataSize ハッシュ表用領域のサイズ
+     * @note ハッシュ表の大きさには、2の冪数のうち領域のサイズを下回らない最大のものが選択されます(15 -> 8, 34 -> 32).
+     *       探査を必ず終わらせるため、格納できるエントリの数はハッシュ表の大きさより一つ少なくなります。
+     * @note ハッシュ表は初期化時に空にするため、コンパイル時には構築できません。
+     */
+    LruCache(LruCacheNode<Key, Value, Size>* const data, const Size& dataSize, Size* const tableData, const Size& tableDataSize)
+        : nodes(data), nodePool(data, dataSize), table(tableData), tableSize(internal::floorPowerOfTwo(tableDataSize)) {
+        clear();
+    };
+
+    LruCache(const LruCache&) = delete;
+    LruCache& operator=(const LruCache&) = delete;
+
+    ~LruCache() = default;
+
+    /**
+     * @brief 追い出し時のコールバックを設定する
+     *
+     * @param callback コールバック (nullptrなら呼び出さない)
+     * @param context コールバックに渡す任意のポインタ
+     * @note 明示的な削除 (`remove`, `clear`) では呼び出されません。
+     */
+    void setEvictionCallback(const EvictionCallback callback, void* const context = nullptr) {
+        evictionCallback = callback;
+        evictionContext = context;
+    }
+
+    /**
+     * @brief キーに対応する値を取得し、そのエントリを最も最近使われたものとする
+     *
+     * @param key キー
+     * @return Value* 値へのポインタ (なければnullptr)
+     */
+    Value* get(const Key& key);
+
+    /**
+     * @brief 使用順を変えずに、キーに対応する値を取得する
+     *
+     * @param key キー
+     * @return const Value* 値へのポインタ (なければnullptr)
+     */
+    const Value* peek(const Key& key) const;
+
+    /**
+     * @brief キーと値を格納し、そのエントリを最も最近使われたものとする
+     *
+     * @param key キー
+     * @param value 値
+     * @return OperationResult 操作結果
+     * @note すでに同じキーが存在する場合は値を上書きします。
+     *       満杯の場合は、最も長く使われていないエントリを追い出してから格納します。
+     */
+    OperationResult put(const Key& key, const Value& value);
+
+    /**
+     * @brief キーに対応するエントリを削除する
+     *
+     * @param key キー
+     * @param value 削除した値の格納先 (nullptrなら読み捨てる)
+     * @return OperationResult 操作結果 (見つからなければEmpty)
+     */
+    OperationResult remove(const Key& key, Value* const value = nullptr);
+
+    /**
+     * @brief 全てのエントリを削除する
+     */
+    void clear();
+
+    /**
+     * @brief 最も長く使われていないエントリを取得
+     *
+     * @return LruCacheNode<Key, Value, Size>* 先頭のノード (空ならnullptr)
+     * @note `next` をたどると、使われていない順に列挙できます。
+     */
+    LruCacheNode<Key, Value, Size>* head() const {
+        return headPtr;
+    }
+
+    /**
+     * @brief キャッシュが持てるエントリの数を返す
+     *
+     * @return Size
+     */
+    Size capacity() const {
+        const Size tableCapacity = tableSize > 0 ? tableSize - 1 : 0;
+        return nodePool.capacity() < tableCapacity ? nodePool.capacity() : tableCapacity;
+    }
+
+    /**
+     * @brief 格納されているエントリの数を返す
+     *
+     * @return Size
+     */
+    Size amount() const {
+        return count;
+    }
+
+    /**
+     * @brief キャッシュが空かどうか
+     *
+     * @return bool
+     */
+    bool isEmpty() const {
+        return count == 0;
+    }
+};
+
+template <typename Key, typename Value, typename Size, typename Hash>
+Size LruCache<Key, Value, Size, Hash>::findSlot(const Key& key) const {
+    Size slot = homeSlot(key);
+    while (table[slot] != 0 && !(nodes[table[slot] - 1].element.key == key)) {
+        slot = (slot + 1) & (tableSize - 1);
+    }
+    return slot;
+}
+
+template <typename Key, typename Value, typename Size, typename Hash>
+void LruCache<Key, Value, Size, Hash>::eraseSlot(Size slot) {
+    // 空きに当たるまで後続のエントリを調べ、本来の位置から空いた位置を越えて探査されるものを詰める
+    Size current = slot;
+    while (true) {
+        current = (current + 1) & (tableSize - 1);
+        if (table[current] == 0) {
+            break;
+        }
+        const Size home = homeSlot(nodes[table[current] - 1].element.key);
+        const bool staysReachable = slot <= current ? (slot < home && home <= current) : (slot < home || home <= current);
+        if (!staysReachable) {
+            table[slot] = table[current];
+            slot = current;
+        }
+    }
+    table[slot] = 0;
+}
+
+template <typename Key, typename Value, typename Size, typename Hash>
+void LruCache<Key, Value, Size, Hash>::unlink(LruCacheNode<Key, Value, Size>* const node) {
+    if (node->previous != nullptr) {
+        node->previous->next = node->next;
+    } else {
+        headPtr = node->next;
+    }
+    if (node->next != nullptr) {
+        node->next->previous = node->previous;
+    } else {
+        tailPtr = node->previous;
+    }
+    node->next = nullptr;
+    node->previous = nullptr;
+}
+
+template <typename Key, typename Value, typename Size, typename Hash>
+void LruCache<Key, Value, Size, Hash>::linkTail(LruCacheNode<Key, Value, Size>* const node) {
+    node->previous = tailPtr;
+    node->next = nullptr;
+    if (tailPtr != nullptr) {
+        tailPtr->next = node;
+    } else {
+        headPtr = node;
+    }
+    tailPtr = node;
+}
+
+template <typename Key, typename Value, typename Size, typename Hash>
+void LruCache<Key, Value, Size, Hash>::removeAt(const Size& slot) {
+    auto* node = nodes + (table[slot] - 1);
+    eraseSlot(slot);
+    unlink(node);
+    nodePool.release(node);
+    count--;
+}
+
+template <typename Key, typename Value, typename Size, typename Hash>
+Value* LruCache<Key, Value, Size, Hash>::get(const Key& key) {
+    if (count == 0) {
+        return nullptr;
+    }
+    const Size slot = findSlot(key);
+    if (table[slot] == 0) {
+        return nullptr;
+    }
+
+    // 最も最近使われた位置へ移す
+    auto* node = nodes + (table[slot] - 1);
+    if (node != tailPtr) {
+        unlink(node);
+        linkTail(node);
+    }
+    return &node->element.value;
+}
+
+template <typename Key, typename Value, typename Size, typename Hash>
+const Value* LruCache<Key, Value, Size, Hash>::peek(const Key& key) const {
+    if (count == 0) {
+        return nullptr;
+    }
+    const Size slot = findSlot(key);
+    return table[slot] != 0 ? &nodes[table[slot] - 1].element.value : nullptr;
+}
+
+template <typename Key, typename Value, typename Size, typename Hash>
+OperationResult LruCache<Key, Value, Size, Hash>::put(const Key& key, const Value& value) {
+    if (capacity() == 0) {
+        return OperationResult::Overflow;
+    }
+
+    // すでにあれば上書きする
+    Size slot = findSlot(key);
+    if (table[slot] != 0) {
+        auto* node = nodes + (table[slot] - 1);
+        node->element.value = value;
+        if (node != tailPtr) {
+            unlink(node);
+            linkTail(node);
+        }
+        return OperationResult::Success;
+    }
+
+    // 満杯なら、最も長く使われていないエントリを追い出す
+    if (count >= capacity()) {
+        auto& evicted = headPtr->element;
+        if (evictionCallback != nullptr) {
+            evictionCallback(evicted.key, evicted.value, evictionContext);
+        }
+        removeAt(findSlot(evicted.key));
+
+        // 詰めたことで空きの位置が変わっている可能性がある
+        slot = findSlot(key);
+    }
+
+    auto* node = nodePool.acquire();
+    node->element.key = key;
+    node->element.value = value;
+    table[slot] = static_cast<Size>(node - nodes) + 1;
+    linkTail(node);
+    count++;
+
+    return OperationResult::Success;
+}
+
+template <typename Key, typename Value, typename Size, typename Hash>
+OperationResult LruCache<Key, Value, Size, Hash>::remove(const Key& key, Value* const value) {
+    if (count == 0) {
+        return OperationResult::Empty;
+    }
+    const Size slot = findSlot(key);
+    if (table[slot] == 0) {
+        return OperationResult::Empty;
+    }
+
+    if (value != nullptr) {
+        *value = nodes[table[slot] - 1].element.value;
+    }
+    removeAt(slot);
+    return OperationResult::Success;
+}
+
+template <typename Key, typename Value, typename Size, typename Hash>
+void LruCache<Key, Value, Size, Hash>::clear() {
+    for (Size i = 0; i < tableSize; i++) {
+        table[i] = 0;
+    }
+    nodePool.reset();
+    headPtr = nullptr;
+    tailPtr = nullptr;
+    count = 0;
+}
+
+}  // namespace collection2
+
+#endif
@@ -0,0 +1,133 @@
+//
+// メモリマップトファイル (POSIX環境のみ)
+//
+
+#ifndef COLLECTION2_MAPPED_FILE_H
+#define COLLECTION2_MAPPED_FILE_H
+
+#include <fcntl.h>
+#include <stddef.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace collection2 {
+
+/**
+ * @brief ファイルを共有マッピングし、永続化コンテナの領域として提供する
+ *
+ * @note POSIX環境向けのヘルパです。`PersistentQueue` や `PersistentBuffer` に `data()`, `size()` を渡して使用します。
+ *       コンテナへの書き込みはマッピングを通じてページキャッシュに反映されるため、プロセスが異常終了してもデータは失われません。
+ *       電源断に備える場合は、任意のタイミングで `flush()` を呼び出してください。
+ */
+class MappedFile {
+   private:
+    /**
+     * @brief ファイルディスクリプタ
+     */
+    int fileDescriptor = -1;
+
+    /**
+     * @brief マッピングの先頭
+     */
+    void* mappedData = nullptr;
+
+    /**
+     * @brief マッピングの大きさ
+     */
+    size_t mappedSize = 0;
+
+   public:
+    MappedFile() = default;
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() {
+        close();
+    }
+
+    /**
+     * @brief ファイルを開いてマッピングする
+     *
+     * @param path ファイルパス (存在しなければ作成されます)
+     * @param size マッピングする大きさ (ファイルがこれより小さければ拡張されます)
+     * @return bool 成功したか
+     */
+    bool open(const char* const path, const size_t& size) {
+        close();
+
+        int fd = ::open(path, O_RDWR | O_CREAT, 0644);
+        if (fd < 0) {
+            return false;
+        }
+
+        // 足りない分はゼロで拡張する
+        struct stat status;
+        if (fstat(fd, &status) != 0 || (static_cast<size_t>(status.st_size) < size && ftruncate(fd, static_cast<off_t>(size)) != 0)) {
+            ::close(fd);
+            return false;
+        }
+
+        void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (data == MAP_FAILED) {
+            ::close(fd);
+            return false;
+        }
+
+        fileDescriptor = fd;
+        mappedData = data;
+        mappedSize = size;
+        return true;
+    }
+
+    /**
+     * @brief マッピングの内容をファイルに書き出し、完了を待つ
+     *
+     * @return bool 成功したか
+     */
+    bool flush() {
+        if (mappedData == nullptr) {
+            return false;
+        }
+        return msync(mappedData, mappedSize, MS_SYNC) == 0;
+    }
+
+    /**
+     * @brief マッピングを解除し、ファイルを閉じる
+     * @note 書き出しの完了は待ちません。必要であれば事前に `flush()` を呼び出してください。
+     */
+    void close() {
+        if (mappedData != nullptr) {
+            munmap(mappedData, mappedSize);
+            mappedData = nullptr;
+            mappedSize = 0;
+        }
+        if (fileDescriptor >= 0) {
+            ::close(fileDescriptor);
+            fileDescriptor = -1;
+        }
+    }
+
+    /**
+     * @brief マッピングの先頭を返す
+     *
+     * @return void* マッピングの先頭 (開いていなければnullptr)
+     */
+    void* data() const {
+        return mappedData;
+    }
+
+    /**
+     * @brief マッピングの大きさを返す
+     *
+     * @return size_t マッピングの大きさ (バイト)
+     */
+    size_t size() const {
+        return mappedSize;
+    }
+};
+
+}  // namespace collection2
+
+#endif
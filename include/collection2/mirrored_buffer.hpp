@@ -0,0 +1,370 @@
+//
+// ミラーリングされたリングバッファ (Linux環境のみ)
+//
+
+#ifndef COLLECTION2_MIRRORED_BUFFER_H
+#define COLLECTION2_MIRRORED_BUFFER_H
+
+// memfd_create と mmap を使用するため、Linux以外の環境ではこのヘッダは何も定義しない
+#if defined(__linux__)
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "common.hpp"
+
+namespace collection2 {
+
+/**
+ * @brief 同じ物理メモリを仮想アドレス上で2回連続してマッピングした領域
+ *
+ * @note Linux向けのヘルパです(memfd_create + mmap)。`data()` から `size()` バイト先にも同じ内容が見えるため、
+ *       領域の末尾をまたぐ読み書きを一つのポインタで扱えます。
+ */
+class MirroredRegion {
+   private:
+    /**
+     * @brief マッピングの先頭
+     */
+    void* mappedData = nullptr;
+
+    /**
+     * @brief マッピング一つ分の大きさ
+     */
+    size_t mappedSize = 0;
+
+   public:
+    MirroredRegion() = default;
+
+    MirroredRegion(const MirroredRegion&) = delete;
+    MirroredRegion& operator=(const MirroredRegion&) = delete;
+
+    ~MirroredRegion() {
+        unmap();
+    }
+
+    /**
+     * @brief 領域を確保し、2回連続してマッピングする
+     *
+     * @param minimumSize 必要な大きさ (バイト)
+     * @param unit 大きさの単位 (バイト)。通常は要素の大きさを指定します
+     * @return bool 成功したか
+     *
+     * @note 実際の大きさは、ページサイズとunitの両方の倍数になるよう切り上げられます。
+     */
+    bool map(const size_t& minimumSize, const size_t& unit = 1);
+
+    /**
+     * @brief マッピングを解除する
+     */
+    void unmap() {
+        if (mappedData != nullptr) {
+            munmap(mappedData, mappedSize * 2);
+            mappedData = nullptr;
+            mappedSize = 0;
+        }
+    }
+
+    /**
+     * @brief マッピングの先頭を返す
+     *
+     * @return void* マッピングの先頭 (確保していなければnullptr)
+     */
+    void* data() const {
+        return mappedData;
+    }
+
+    /**
+     * @brief マッピング一つ分の大きさを返す
+     *
+     * @return size_t 大きさ (バイト)
+     */
+    size_t size() const {
+        return mappedSize;
+    }
+};
+
+inline bool MirroredRegion::map(const size_t& minimumSize, const size_t& unit) {
+    unmap();
+    if (minimumSize == 0 || unit == 0) {
+        return false;
+    }
+
+    // ページサイズとunitの最小公倍数の倍数に切り上げる
+    const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t a = pageSize;
+    size_t b = unit;
+    while (b != 0) {
+        const size_t remainder = a % b;
+        a = b;
+        b = remainder;
+    }
+    const size_t granularity = pageSize / a * unit;
+    const size_t size = (minimumSize + granularity - 1) / granularity * granularity;
+
+    // 実体となるメモリファイルを作成
+    const int fd = memfd_create("collection2", MFD_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        close(fd);
+        return false;
+    }
+
+    // 2倍の大きさのアドレス空間を予約し、前半と後半に同じファイルを重ねる
+    auto* reserved = static_cast<uint8_t*>(mmap(nullptr, size * 2, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+    if (reserved == MAP_FAILED) {
+        close(fd);
+        return false;
+    }
+    const bool mapped =
+        mmap(reserved, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED &&
+        mmap(reserved + size, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED;
+    close(fd);
+    if (!mapped) {
+        munmap(reserved, size * 2);
+        return false;
+    }
+
+    mappedData = reserved;
+    mappedSize = size;
+    return true;
+}
+
+/**
+ * @brief ミラーリングされた領域を使用するリングバッファ
+ *
+ * @tparam Element 要素の型 (構築されていない領域に書き込み、もう一方のマッピングから読み出すため、トリビアルにコピー可能である必要があります)
+ * @tparam Size
+ *
+ * @note 領域の直後に同じ内容が見えるため、先頭から格納済みの全要素、末尾から空き領域の全体を、常に一つの連続した配列として参照できます。
+ *       フレームが折り返し位置をまたいでいても、パーサや `write()` にそのまま渡せます。
+ */
+template <typename Element, typename Size = size_t>
+class MirroredBuffer {
+    static_assert(internal::IsTriviallyCopyable<Element>::value, "collection2::MirroredBuffer: Element must be trivially copyable");
+
+   private:
+    /**
+     * @brief 内部データ管理領域
+     */
+    Element* const internalData;
+
+    /**
+     * @brief 内部データ長さ
+     */
+    Size internalDataSize;
+
+    /**
+     * @brief バッファ先頭
+     */
+    Size head = 0;
+
+    /**
+     * @brief 現在バッファ内に存在するデータ数
+     */
+    Size count = 0;
+
+    /**
+     * @brief 位置を進める
+     *
+     * @param position 現在の位置
+     * @param length 進める量
+     * @return Size 進めた位置
+     * @note 容量は2の冪数とは限らないため、比較と減算で折り返します。加算は容量がSizeの上限に近くても溢れないように行います。
+     */
+    Size advance(const Size& position, const Size& length) const {
+        const Size remaining = internalDataSize - position;
+        return length >= remaining ? length - remaining : position + length;
+    }
+
+    /**
+     * @brief 領域の要素数がSizeで表せる場合はその値を、表せない場合は0を返す
+     *
+     * @param elements 領域の要素数
+     * @return Size バッファの容量
+     * @note ミラーの折り返し位置は領域の末尾に固定されるため、容量を切り詰めて使うことはできません。
+     */
+    static Size capacityFor(const size_t& elements) {
+        return elements <= static_cast<size_t>(static_cast<Size>(~static_cast<Size>(0))) ? static_cast<Size>(elements) : 0;
+    }
+
+   public:
+    /**
+     * @brief ミラーリングされた領域とそのサイズ(要素数)を指定してバッファを初期化
+     *
+     * @param data 内部データ保管用領域 (`MirroredRegion` などで、直後に同じ内容がマッピングされている必要があります)
+     * @param dataSize 領域サイズ (ミラー一つ分の要素数)
+     */
+    MirroredBuffer(Element* const data, const Size& dataSize) : internalData(data), internalDataSize(dataSize){};
+
+    /**
+     * @brief ミラーリングされた領域を指定してバッファを初期化
+     *
+     * @param region 領域
+     * @note 領域の要素数が `Size` で表せない場合、バッファは空(容量0)として扱われます。
+     */
+    explicit MirroredBuffer(const MirroredRegion& region)
+        : internalData(static_cast<Element*>(region.data())), internalDataSize(capacityFor(region.size() / sizeof(Element))){};
+
+    MirroredBuffer(const MirroredBuffer&) = delete;
+    MirroredBuffer& operator=(const MirroredBuffer&) = delete;
+
+    ~MirroredBuffer() = default;
+
+    /**
+     * @brief バッファの末尾にデータを追加
+     *
+     * @param data 追加するデータ
+     * @return OperationResult 操作結果
+     * @note バッファがいっぱいの場合は、先頭のデータが捨てられます。
+     */
+    OperationResult append(const Element& data);
+
+    /**
+     * @brief バッファの先頭からデータを取り出し
+     *
+     * @param data 取り出したデータの格納先 (nullptrの場合は読み捨てる)
+     * @return OperationResult 操作結果
+     */
+    OperationResult pop(Element* const data);
+
+    /**
+     * @brief 格納済みのデータを先頭から参照する
+     *
+     * @return const Element* 先頭のデータへのポインタ。ここから `amount()` 個のデータが連続して並んでいます
+     */
+    const Element* readableData() const {
+        return internalData + head;
+    }
+
+    /**
+     * @brief 先頭からデータを読み捨てる
+     *
+     * @param length 読み捨てる数
+     * @return OperationResult 操作結果
+     * @note データが足りない場合は何もせずにEmptyを返します。
+     */
+    OperationResult consume(const Size& length);
+
+    /**
+     * @brief 空き領域を末尾から参照する
+     *
+     * @return Element* 末尾の空き領域へのポインタ。ここから `capacity() - amount()` 個の領域が連続して並んでいます
+     */
+    Element* writableData() {
+        return internalData + advance(head, count);
+    }
+
+    /**
+     * @brief `writableData()` に書き込んだデータを確定する
+     *
+     * @param length 確定する数
+     * @return OperationResult 操作結果
+     * @note 空きが足りない場合は何もせずにOverflowを返します。
+     */
+    OperationResult commit(const Size& length);
+
+    /**
+     * @brief バッファの全体長を返す
+     *
+     * @return Size バッファ長
+     */
+    Size capacity() const {
+        return internalDataSize;
+    }
+
+    /**
+     * @brief 現在バッファ内にあるデータ数を返す
+     *
+     * @return Size バッファ内に存在するデータの数
+     */
+    Size amount() const {
+        return count;
+    }
+
+    /**
+     * @brief バッファに値を追加できるか
+     *
+     * @return bool
+     */
+    bool hasSpace() const {
+        return count < internalDataSize;
+    }
+
+    /**
+     * @brief バッファが空かどうか
+     *
+     * @return bool
+     */
+    bool isEmpty() const {
+        return count == 0;
+    }
+};
+
+template <typename Element, typename Size>
+OperationResult MirroredBuffer<Element, Size>::append(const Element& data) {
+    // サイズ0のバッファに値を追加することはできない
+    if (internalDataSize == 0) {
+        return OperationResult::Overflow;
+    }
+
+    // バッファがいっぱいなら、要素を一つ読み捨てる
+    if (!hasSpace()) {
+        pop(nullptr);
+    }
+
+    *writableData() = data;
+    count++;
+
+    return OperationResult::Success;
+}
+
+template <typename Element, typename Size>
+OperationResult MirroredBuffer<Element, Size>::pop(Element* const data) {
+    // バッファが空なら戻る
+    if (isEmpty()) {
+        return OperationResult::Empty;
+    }
+
+    // 読み出して渡す。nullptrなら何もしないでheadを進める。
+    if (data != nullptr) {
+        *data = *(internalData + head);
+    }
+    head = advance(head, 1);
+    count--;
+
+    return OperationResult::Success;
+}
+
+template <typename Element, typename Size>
+OperationResult MirroredBuffer<Element, Size>::consume(const Size& length) {
+    if (count < length) {
+        return OperationResult::Empty;
+    }
+
+    head = advance(head, length);
+    count -= length;
+
+    return OperationResult::Success;
+}
+
+template <typename Element, typename Size>
+OperationResult MirroredBuffer<Element, Size>::commit(const Size& length) {
+    if (internalDataSize - count < length) {
+        return OperationResult::Overflow;
+    }
+
+    count += length;
+
+    return OperationResult::Success;
+}
+
+}  // namespace collection2
+
+#endif  // defined(__linux__)
+
+#endif
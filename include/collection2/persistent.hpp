@@ -0,0 +1,416 @@
+//
+// 永続化キュー・リングバッファ
+//
+
+#ifndef COLLECTION2_PERSISTENT_H
+#define COLLECTION2_PERSISTENT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "common.hpp"
+
+namespace collection2 {
+
+namespace internal {
+
+/**
+ * @brief 永続化領域の先頭に置かれるヘッダ
+ *
+ * @tparam Size 要素数の型
+ * @note head, tailは容量で丸めずに増え続けるインデックスです。格納数は tail - head で求まるため、各操作で書き換えるインデックスは一つだけになります。
+ */
+template <typename Size>
+struct PersistentRingHeader {
+    /// @brief 領域が初期化済みであることを示す値
+    uint32_t magic;
+
+    /// @brief レイアウトのバージョン
+    uint16_t version;
+
+    /// @brief 要素の大きさ (型の取り違えを検出する)
+    uint16_t elementSize;
+
+    /// @brief 容量
+    Size capacity;
+
+    /// @brief 先頭 (読み出し位置)
+    Size head;
+
+    /// @brief 末尾 (書き込み位置)
+    Size tail;
+};
+
+/// @brief ヘッダのマジックナンバー ("C2RB")
+constexpr uint32_t persistentRingMagic = 0x43325242;
+
+/// @brief ヘッダのバージョン
+constexpr uint16_t persistentRingVersion = 1;
+
+/**
+ * @brief 永続化領域を検証し、必要であれば初期化する
+ *
+ * @tparam Element 要素の型
+ * @tparam Size 要素数の型
+ * @param region 領域
+ * @param regionSize 領域の大きさ (バイト)
+ * @param header ヘッダへのポインタの格納先 (領域が小さすぎる場合はnullptr)
+ * @param data 要素領域へのポインタの格納先
+ * @return bool 既存のデータを復元したか
+ */
+template <typename Element, typename Size>
+bool attachPersistentRing(void* const region, const size_t& regionSize, PersistentRingHeader<Size>** header, Element** data) {
+    *header = nullptr;
+    *data = nullptr;
+
+    // 要素領域はヘッダの直後、要素のアラインメントに揃えた位置から始まる
+    const size_t alignment = alignof(Element);
+    const size_t dataOffset = (sizeof(PersistentRingHeader<Size>) + alignment - 1) / alignment * alignment;
+    if (region == nullptr || regionSize < dataOffset + sizeof(Element)) {
+        return false;
+    }
+    *header = static_cast<PersistentRingHeader<Size>*>(region);
+    *data = reinterpret_cast<Element*>(static_cast<unsigned char*>(region) + dataOffset);
+
+    // 領域に収まる最大の2の冪数を容量とする
+    // ただし tail - head で格納数を表せるよう、Sizeの最上位ビットまでに留める
+    const size_t maxCapacity = (static_cast<size_t>(static_cast<Size>(~static_cast<Size>(0))) >> 1) + 1;
+    size_t slots = (regionSize - dataOffset) / sizeof(Element);
+    size_t capacityCandidate = 1;
+    while ((slots >>= 1) != 0 && capacityCandidate < maxCapacity) {
+        capacityCandidate <<= 1;
+    }
+    const Size capacity = static_cast<Size>(capacityCandidate);
+
+    // 既存のヘッダが同じ構成で、インデックスが矛盾していなければ復元する
+    auto* existing = *header;
+    if (existing->magic == persistentRingMagic &&
+        existing->version == persistentRingVersion &&
+        existing->elementSize == sizeof(Element) &&
+        existing->capacity == capacity &&
+        static_cast<Size>(existing->tail - existing->head) <= capacity) {
+        return true;
+    }
+
+    // 初期化 マジックナンバーは最後に書き込み、途中で落ちても初期化済みと誤認しないようにする
+    existing->magic = 0;
+    compilerBarrier();
+    existing->version = persistentRingVersion;
+    existing->elementSize = sizeof(Element);
+    existing->capacity = capacity;
+    existing->head = 0;
+    existing->tail = 0;
+    compilerBarrier();
+    existing->magic = persistentRingMagic;
+    return false;
+}
+
+}  // namespace internal
+
+/**
+ * @brief 呼び出し側の領域にインデックスごと格納される、永続化キュー
+ *
+ * @tparam Element 要素の型 (バイト列としてそのまま保存されるため、トリビアルにコピー可能である必要があります)
+ * @tparam Size 要素数の型
+ *
+ * @note 領域にはヘッダ(マジックナンバー、容量、インデックス)と要素が格納されます。
+ *       同じ領域を再度渡すと、以前の内容がそのまま復元されます。
+ *       mmapしたファイルやリセットで消えないRAMを渡すことで、プロセスの再起動を越えてデータを保持できます。
+ * @note 領域の永続化 (msync等) は行いません。任意のタイミングで呼び出し側がフラッシュしてください。
+ */
+template <typename Element, typename Size = size_t>
+class PersistentQueue {
+    static_assert(internal::IsTriviallyCopyable<Element>::value, "collection2::PersistentQueue: Element must be trivially copyable");
+
+   private:
+    /**
+     * @brief ヘッダ
+     */
+    internal::PersistentRingHeader<Size>* header;
+
+    /**
+     * @brief 内部データ管理領域
+     */
+    Element* internalData;
+
+    /**
+     * @brief 既存のデータを復元したか
+     */
+    bool restored;
+
+   public:
+    /**
+     * @brief 永続化領域を指定してキューを初期化
+     *
+     * @param region 永続化領域 (ヘッダの型に合わせて整列している必要があります)
+     * @param regionSize 領域の大きさ (バイト)
+     * @note 容量は、ヘッダを除いた領域に収まる最大の2の冪数になります。
+     */
+    PersistentQueue(void* const region, const size_t& regionSize) {
+        restored = internal::attachPersistentRing(region, regionSize, &header, &internalData);
+    }
+
+    PersistentQueue(const PersistentQueue&) = delete;
+    PersistentQueue& operator=(const PersistentQueue&) = delete;
+
+    ~PersistentQueue() = default;
+
+    /**
+     * @brief キューにデータを追加
+     *
+     * @param data 追加するデータ
+     * @return OperationResult 操作結果
+     */
+    OperationResult enqueue(const Element& data);
+
+    /**
+     * @brief キューからデータを取り出し
+     *
+     * @param data 取り出したデータの格納先
+     * @return OperationResult 操作結果
+     */
+    OperationResult dequeue(Element* const data);
+
+    /**
+     * @brief キューを空にする
+     */
+    void clear() {
+        if (header != nullptr) {
+            header->head = header->tail;
+        }
+    }
+
+    /**
+     * @brief 構築時に既存のデータを復元したか
+     *
+     * @return bool
+     */
+    bool isRestored() const {
+        return restored;
+    }
+
+    /**
+     * @brief キューの全体長を返す
+     *
+     * @return Size キュー長
+     */
+    Size capacity() const {
+        return header == nullptr ? 0 : header->capacity;
+    }
+
+    /**
+     * @brief 現在キュー内にあるデータ数を返す
+     *
+     * @return Size キュー内に存在するデータの数
+     */
+    Size amount() const {
+        return header == nullptr ? 0 : static_cast<Size>(header->tail - header->head);
+    }
+
+    /**
+     * @brief キューに値を追加できるか
+     *
+     * @return bool
+     */
+    bool hasSpace() const {
+        return amount() < capacity();
+    }
+
+    /**
+     * @brief キューが空かどうか
+     *
+     * @return bool
+     */
+    bool isEmpty() const {
+        return amount() == 0;
+    }
+};
+
+template <typename Element, typename Size>
+OperationResult PersistentQueue<Element, Size>::enqueue(const Element& data) {
+    // キューがいっぱいなら戻る
+    if (!hasSpace()) {
+        return OperationResult::Overflow;
+    }
+
+    // 要素を書き込んでからtailを公開する
+    *(internalData + (header->tail & (header->capacity - 1))) = data;
+    internal::compilerBarrier();
+    header->tail++;
+
+    return OperationResult::Success;
+}
+
+template <typename Element, typename Size>
+OperationResult PersistentQueue<Element, Size>::dequeue(Element* const data) {
+    // キューが空なら戻る
+    if (isEmpty()) {
+        return OperationResult::Empty;
+    }
+
+    // 読み出してからheadを進める
+    *data = *(internalData + (header->head & (header->capacity - 1)));
+    internal::compilerBarrier();
+    header->head++;
+
+    return OperationResult::Success;
+}
+
+/**
+ * @brief 呼び出し側の領域にインデックスごと格納される、永続化リングバッファ
+ *
+ * @tparam Element 要素の型 (バイト列としてそのまま保存されるため、トリビアルにコピー可能である必要があります)
+ * @tparam Size 要素数の型
+ *
+ * @note 領域のレイアウトは `PersistentQueue` と共通です。満杯の状態で追加すると、最も古いデータが捨てられます。
+ * @note 領域の永続化 (msync等) は行いません。任意のタイミングで呼び出し側がフラッシュしてください。
+ */
+template <typename Element, typename Size = size_t>
+class PersistentBuffer {
+    static_assert(internal::IsTriviallyCopyable<Element>::value, "collection2::PersistentBuffer: Element must be trivially copyable");
+
+   private:
+    /**
+     * @brief ヘッダ
+     */
+    internal::PersistentRingHeader<Size>* header;
+
+    /**
+     * @brief 内部データ管理領域
+     */
+    Element* internalData;
+
+    /**
+     * @brief 既存のデータを復元したか
+     */
+    bool restored;
+
+   public:
+    /**
+     * @brief 永続化領域を指定してバッファを初期化
+     *
+     * @param region 永続化領域 (ヘッダの型に合わせて整列している必要があります)
+     * @param regionSize 領域の大きさ (バイト)
+     * @note 容量は、ヘッダを除いた領域に収まる最大の2の冪数になります。
+     */
+    PersistentBuffer(void* const region, const size_t& regionSize) {
+        restored = internal::attachPersistentRing(region, regionSize, &header, &internalData);
+    }
+
+    PersistentBuffer(const PersistentBuffer&) = delete;
+    PersistentBuffer& operator=(const PersistentBuffer&) = delete;
+
+    ~PersistentBuffer() = default;
+
+    /**
+     * @brief バッファの末尾にデータを追加
+     *
+     * @param data 追加するデータ
+     * @return OperationResult 操作結果
+     */
+    OperationResult append(const Element& data);
+
+    /**
+     * @brief バッファの先頭からデータを取り出し
+     *
+     * @param data 取り出したデータの格納先 (nullptrの場合は読み捨てる)
+     * @return OperationResult 操作結果
+     */
+    OperationResult pop(Element* const data);
+
+    /**
+     * @brief バッファを空にする
+     */
+    void clear() {
+        if (header != nullptr) {
+            header->head = header->tail;
+        }
+    }
+
+    /**
+     * @brief 構築時に既存のデータを復元したか
+     *
+     * @return bool
+     */
+    bool isRestored() const {
+        return restored;
+    }
+
+    /**
+     * @brief バッファの全体長を返す
+     *
+     * @return Size バッファ長
+     */
+    Size capacity() const {
+        return header == nullptr ? 0 : header->capacity;
+    }
+
+    /**
+     * @brief 現在バッファ内にあるデータ数を返す
+     *
+     * @return Size バッファ内に存在するデータの数
+     */
+    Size amount() const {
+        return header == nullptr ? 0 : static_cast<Size>(header->tail - header->head);
+    }
+
+    /**
+     * @brief バッファに値を追加できるか
+     *
+     * @return bool
+     */
+    bool hasSpace() const {
+        return amount() < capacity();
+    }
+
+    /**
+     * @brief バッファが空かどうか
+     *
+     * @return bool
+     */
+    bool isEmpty() const {
+        return amount() == 0;
+    }
+};
+
+template <typename Element, typename Size>
+OperationResult PersistentBuffer<Element, Size>::append(const Element& data) {
+    // サイズ0のバッファに値を追加することはできない
+    if (capacity() == 0) {
+        return OperationResult::Overflow;
+    }
+
+    // バッファがいっぱいなら、要素を一つ読み捨てる
+    if (!hasSpace()) {
+        header->head++;
+        internal::compilerBarrier();
+    }
+
+    // 要素を書き込んでからtailを公開する
+    *(internalData + (header->tail & (header->capacity - 1))) = data;
+    internal::compilerBarrier();
+    header->tail++;
+
+    return OperationResult::Success;
+}
+
+template <typename Element, typename Size>
+OperationResult PersistentBuffer<Element, Size>::pop(Element* const data) {
+    // バッファが空なら戻る
+    if (isEmpty()) {
+        return OperationResult::Empty;
+    }
+
+    // 読み出して渡す。nullptrなら何もしないでheadを進める。
+    if (data != nullptr) {
+        *data = *(internalData + (header->head & (header->capacity - 1)));
+    }
+    internal::compilerBarrier();
+    header->head++;
+
+    return OperationResult::Success;
+}
+
+}  // namespace collection2
+
+#endif
@@ -0,0 +1,370 @@
+//
+// オブジェクトプール
+//
+
+#ifndef COLLECTION2_POOL_H
+#define COLLECTION2_POOL_H
+
+#include <stddef.h>
+#include <string.h>
+
+#include "common.hpp"
+
+namespace collection2 {
+
+/**
+ * @brief 固定長オブジェクトプール
+ *
+ * @tparam T 管理するオブジェクトの型
+ * @tparam Size 要素数の型
+ * @tparam Policy 並行性ポリシー (複数のスレッドから同時に確保・返却する場合は `concurrent_pool.hpp` の `LockFree` を指定します)
+ *
+ * @note 返却されたスロットは、スロット自身の領域に次の空きスロットのインデックスを書き込んだ単方向リストで管理されます。
+ *       そのため、`T` の大きさは `Size` 以上である必要があります。
+ * @note スロットのアラインメントは呼び出し側が用意する領域に従います。特定の境界に揃えたい場合は、領域または `T` を `alignas` 付きで宣言してください。
+ */
+template <typename T, typename Size = size_t, typename Policy = SingleContext>
+class Pool {
+    static_assert(sizeof(T) >= sizeof(Size), "collection2::Pool: sizeof(T) must be greater than or equal to sizeof(Size)");
+
+   private:
+    /**
+     * @brief 内部データ管理領域
+     */
+    T* const internalData;
+
+    /**
+     * @brief 内部データ長さ
+     */
+    Size internalDataSize;
+
+    /**
+     * @brief まだ一度も払い出されていない領域の先頭
+     * @note これ以降のスロットには、呼び出し側が構築したオブジェクトがそのまま残っています。
+     */
+    Size untouchedHead = 0;
+
+    /**
+     * @brief 返却済みスロットのリストの先頭 (internalDataSizeなら空)
+     */
+    Size freeHead;
+
+    /**
+     * @brief 払い出し中のオブジェクト数
+     */
+    Size count = 0;
+
+    /**
+     * @brief 返却済みスロットに書き込まれた次の空きスロットのインデックスを読む
+     *
+     * @param index 対象スロット
+     * @return Size 次の空きスロット
+     */
+    Size readLink(const Size& index) const {
+        Size link;
+        memcpy(&link, static_cast<const void*>(internalData + index), sizeof(Size));
+        return link;
+    }
+
+    /**
+     * @brief 返却済みスロットに次の空きスロットのインデックスを書き込む
+     *
+     * @param index 対象スロット
+     * @param link 次の空きスロット
+     */
+    void writeLink(const Size& index, const Size& link) {
+        memcpy(static_cast<void*>(internalData + index), &link, sizeof(Size));
+    }
+
+    /**
+     * @brief 空きスロットを一つ取り出す
+     *
+     * @return void* オブジェクトを構築できる領域。空きがない場合はnullptrが返ります。
+     */
+    void* takeSlot();
+
+   public:
+    /**
+     * @brief 内部データを扱う領域とそのサイズを指定してプールを初期化
+     *
+     * @param data 内部データ保管用領域
+     * @param dataSize 領域サイズ
+     */
+    constexpr Pool(T* const data, const Size& dataSize);
+
+    /**
+     * @brief 先頭の一部がすでに使用されている領域を指定してプールを初期化
+     *
+     * @param data 内部データ保管用領域
+     * @param dataSize 領域サイズ
+     * @param usedSize 払い出し済みとして扱う先頭のスロット数
+     * @note 静的に初期化したオブジェクトを領域の先頭に並べておき、実行時の構築を省く場合に使用します。
+     */
+    constexpr Pool(T* const data, const Size& dataSize, const Size& usedSize);
+
+    Pool(const Pool&) = delete;
+    Pool& operator=(const Pool&) = delete;
+
+    /**
+     * @brief プールを破棄する
+     * @note 呼び出し側の領域には触れません。返却済みのスロットにはオブジェクトが存在しないため、
+     *       `T` のデストラクタが必要な型で、領域を配列のまま破棄する場合は、事前に `reset` を呼び出してください。
+     */
+    ~Pool() = default;
+
+    /**
+     * @brief オブジェクトをデフォルト構築して払い出す
+     *
+     * @return T* 払い出したオブジェクトへのポインタ
+     * @note 空きスロットがない場合はnullptrが返ります。
+     */
+    T* acquire();
+
+    /**
+     * @brief オブジェクトをコピー構築して払い出す
+     *
+     * @param value 構築元の値
+     * @return T* 払い出したオブジェクトへのポインタ
+     * @note 空きスロットがない場合はnullptrが返ります。
+     */
+    T* acquire(const T& value);
+
+    /**
+     * @brief オブジェクトを破棄し、プールに返却する
+     *
+     * @param object 返却するオブジェクト
+     * @return OperationResult 操作結果
+     * @note このプールが払い出したものでないポインタを渡した場合は何もせずEmptyが返ります。二重返却は検出しません。
+     */
+    OperationResult release(T* const object);
+
+    /**
+     * @brief プールを初期状態に戻す
+     * @note 払い出し中のオブジェクトも含め、全てのスロットが空きとして扱われます。
+     */
+    void reset();
+
+    /**
+     * @brief ポインタがこのプールの管理領域内を指しているか
+     *
+     * @param object 調べるポインタ
+     * @return bool
+     */
+    bool owns(const T* const object) const {
+        return object != nullptr && object >= internalData && object < internalData + internalDataSize;
+    }
+
+    /**
+     * @brief プールの全体長を返す
+     *
+     * @return Size プール長
+     */
+    constexpr Size capacity() const {
+        return internalDataSize;
+    }
+
+    /**
+     * @brief 払い出し中のオブジェクト数を返す
+     *
+     * @return Size 払い出し中のオブジェクト数
+     */
+    constexpr Size amount() const {
+        return count;
+    }
+
+    /**
+     * @brief オブジェクトを払い出せるか
+     *
+     * @return bool
+     */
+    constexpr bool hasSpace() const {
+        return count < internalDataSize;
+    }
+
+    /**
+     * @brief 払い出し中のオブジェクトがないか
+     *
+     * @return bool
+     */
+    constexpr bool isEmpty() const {
+        return count == 0;
+    }
+};
+
+template <typename T, typename Size, typename Policy>
+constexpr Pool<T, Size, Policy>::Pool(T* const data, const Size& dataSize)
+    : internalData(data), internalDataSize(dataSize), freeHead(dataSize){};
+
+template <typename T, typename Size, typename Policy>
+constexpr Pool<T, Size, Policy>::Pool(T* const data, const Size& dataSize, const Size& usedSize)
+    : internalData(data),
+      internalDataSize(dataSize),
+      untouchedHead(usedSize < dataSize ? usedSize : dataSize),
+      freeHead(dataSize),
+      count(usedSize < dataSize ? usedSize : dataSize){};
+
+template <typename T, typename Size, typename Policy>
+void* Pool<T, Size, Policy>::takeSlot() {
+    // 返却済みスロットがあればそれを使う
+    if (freeHead != internalDataSize) {
+        const Size index = freeHead;
+        freeHead = readLink(index);
+        return internalData + index;
+    }
+
+    // 未使用領域から切り出す 呼び出し側が構築したオブジェクトはここで破棄する
+    if (untouchedHead < internalDataSize) {
+        T* slot = internalData + untouchedHead;
+        untouchedHead++;
+        slot->~T();
+        return slot;
+    }
+
+    return nullptr;
+}
+
+template <typename T, typename Size, typename Policy>
+T* Pool<T, Size, Policy>::acquire() {
+    void* slot = takeSlot();
+    if (slot == nullptr) {
+        return nullptr;
+    }
+
+    count++;
+    return new (internal::PlacementTag(), slot) T();
+}
+
+template <typename T, typename Size, typename Policy>
+T* Pool<T, Size, Policy>::acquire(const T& value) {
+    void* slot = takeSlot();
+    if (slot == nullptr) {
+        return nullptr;
+    }
+
+    count++;
+    return new (internal::PlacementTag(), slot) T(value);
+}
+
+template <typename T, typename Size, typename Policy>
+OperationResult Pool<T, Size, Policy>::release(T* const object) {
+    if (isEmpty() || !owns(object)) {
+        return OperationResult::Empty;
+    }
+
+    // オブジェクトを破棄し、空いた領域を返却済みリストの先頭に繋ぐ
+    const Size index = static_cast<Size>(object - internalData);
+    object->~T();
+    writeLink(index, freeHead);
+    freeHead = index;
+    count--;
+
+    return OperationResult::Success;
+}
+
+template <typename T, typename Size, typename Policy>
+void Pool<T, Size, Policy>::reset() {
+    // 返却済みスロットにオブジェクトを置き直す
+    while (freeHead != internalDataSize) {
+        const Size index = freeHead;
+        freeHead = readLink(index);
+        new (internal::PlacementTag(), internalData + index) T();
+    }
+
+    // 全てのスロットに有効なオブジェクトがある状態 = 未使用領域として扱える
+    untouchedHead = 0;
+    count = 0;
+}
+
+namespace internal {
+
+/**
+ * @brief リスト・ツリーが使うノードプールを保持する
+ *
+ * @tparam T ノードの型
+ * @tparam Size 要素数の型
+ * @tparam Policy コンテナに指定された並行性ポリシー
+ * @note 対応するポリシーは `SingleContext`・`SharedPool`・`LockFree` のみです(特殊化を参照)。
+ *       それ以外のポリシー(`InterruptToMain` など)ではノードプールへのアクセスを同期できないため、コンパイルエラーになります。
+ */
+template <typename T, typename Size, typename Policy>
+class NodePoolHolder {
+    static_assert(sizeof(Policy) == 0, "collection2::NodePoolHolder: Policy must be SingleContext, SharedPool or LockFree");
+};
+
+/**
+ * @brief リスト・ツリーが使うノードプールを保持する (ロックフリーな共有プール)
+ */
+template <typename T, typename Size>
+class NodePoolHolder<T, Size, LockFree> {
+   public:
+    /**
+     * @brief 保持するプールの型
+     */
+    using PoolType = Pool<T, Size, LockFree>;
+
+    /**
+     * @brief 専用のプールを内部に持つか
+     */
+    static constexpr bool owning = false;
+
+    explicit constexpr NodePoolHolder(PoolType& pool) : poolPtr(&pool){};
+
+    constexpr PoolType* operator->() const {
+        return poolPtr;
+    }
+
+   private:
+    PoolType* const poolPtr;
+};
+
+/**
+ * @brief リスト・ツリーが使うノードプールを保持する (単一コンテキストの共有プール)
+ */
+template <typename T, typename Size>
+class NodePoolHolder<T, Size, SharedPool> {
+   public:
+    using PoolType = Pool<T, Size>;
+
+    static constexpr bool owning = false;
+
+    explicit constexpr NodePoolHolder(PoolType& pool) : poolPtr(&pool){};
+
+    constexpr PoolType* operator->() const {
+        return poolPtr;
+    }
+
+   private:
+    PoolType* const poolPtr;
+};
+
+/**
+ * @brief リスト・ツリーが使うノードプールを保持する (専用のプールを内部に持つ)
+ */
+template <typename T, typename Size>
+class NodePoolHolder<T, Size, SingleContext> {
+   public:
+    using PoolType = Pool<T, Size>;
+
+    static constexpr bool owning = true;
+
+    constexpr NodePoolHolder(T* const data, const Size& dataSize) : pool(data, dataSize){};
+
+    constexpr NodePoolHolder(T* const data, const Size& dataSize, const Size& usedSize) : pool(data, dataSize, usedSize){};
+
+    PoolType* operator->() {
+        return &pool;
+    }
+
+    constexpr const PoolType* operator->() const {
+        return &pool;
+    }
+
+   private:
+    PoolType pool;
+};
+
+}  // namespace internal
+
+}  // namespace collection2
+
+#endif
@@ -16,8 +16,13 @@ namespace collection2 {
  *
  * @tparam Element
  * @tparam Size
+ * @tparam Policy 並行性ポリシー (割り込みハンドラと共有する場合は `interrupt.hpp` のポリシーを指定します)
+ * @tparam Indexing 添字ポリシー (領域全体を使用する場合は `ExactCapacity` を指定します)
+ *
+ * @note 先頭・末尾の管理は添字ポリシーが決めます。既定の添字ポリシーではデータ数を持たず、容量で丸めずに増え続けるhead/tailの差から求めます。
+ *       追加はtailだけを、取り出しはheadだけを書き換えます。`ExactCapacity` では容量をSizeの最大値まで使えるよう、位置とデータ数を持ちます。
  */
-template <typename Element, typename Size = size_t>
+template <typename Element, typename Size = size_t, typename Policy = SingleContext, typename Indexing = PowerOfTwoCapacity>
 class Queue {
    private:
     /**
@@ -31,19 +36,9 @@ class Queue {
     Size internalDataSize;
 
     /**
-     * @brief キュー先頭
-     */
-    Size head = 0;
-
-    /**
-     * @brief キュー末尾
-     */
-    Size tail = 0;
-
-    /**
-     * @brief 現在キュー内に存在するデータ数
+     * @brief キューの先頭・末尾
      */
-    Size count = 0;
+    typename Indexing::template QueueCursor<Size> cursor;
 
    public:
     /**
@@ -51,9 +46,10 @@ class Queue {
      *
      * @param data 内部データ保管用領域
      * @param dataSize 領域サイズ
-     * @note 領域サイズは2の冪乗であるべきです。それ以外の値を指定した場合、2の冪数のうち領域のサイズを下回らない最大のものが選択されます(15 -> 8, 34 -> 32).
+     * @note 既定の添字ポリシーでは、領域サイズは2の冪乗であるべきです。それ以外の値を指定した場合、2の冪数のうち領域のサイズを下回らない最大のものが選択されます(15 -> 8, 34 -> 32).
+     *       `ExactCapacity` を指定した場合は領域全体が使用されます。
      */
-    Queue(Element* const data, const Size& dataSize);
+    constexpr Queue(Element* const data, const Size& dataSize);
 
     Queue(const Queue&) = delete;
     Queue& operator=(const Queue&) = delete;
@@ -66,7 +62,7 @@ class Queue {
      * @param data 追加するデータ
      * @return OperationResult 操作結果
      */
-    OperationResult enqueue(const Element& data);
+    COLLECTION2_CONSTEXPR14 OperationResult enqueue(const Element& data);
 
     /**
      * @brief キューからデータを取り出し
@@ -74,14 +70,63 @@ class Queue {
      * @param data 取り出したデータの格納先
      * @return OperationResult 操作結果
      */
-    OperationResult dequeue(Element* const data);
+    COLLECTION2_CONSTEXPR14 OperationResult dequeue(Element* const data);
+
+    /**
+     * @brief キューに複数のデータをまとめて追加
+     *
+     * @param data 追加するデータの配列
+     * @param length 追加するデータの数
+     * @return OperationResult 操作結果
+     *
+     * @note 空きが足りない場合は何も追加せずにOverflowを返します。
+     * @note トリビアルにコピー可能な型では、折り返し位置の前後それぞれを一度にコピーします。
+     */
+    OperationResult enqueueN(const Element* const data, const Size& length);
+
+    /**
+     * @brief キューから複数のデータをまとめて取り出し
+     *
+     * @param data 取り出したデータの格納先 (取り出した順に格納される)
+     * @param length 取り出すデータの数
+     * @return OperationResult 操作結果
+     *
+     * @note データが足りない場合は何も取り出さずにEmptyを返します。
+     */
+    OperationResult dequeueN(Element* const data, const Size& length);
+
+    /**
+     * @brief キューの先頭から最大maxItems個のデータを、取り出さずにその場でコールバックへ渡してから読み捨てる
+     *
+     * @tparam Callback `void(Element&)` として呼び出せる関数オブジェクト
+     * @param maxItems 処理するデータの最大数
+     * @param callback 各データに対して呼び出すコールバック
+     * @return Size 処理したデータの数
+     *
+     * @note 処理できる範囲を最初に一度だけ確定し、先頭の位置は最後に一度だけ更新します。
+     * @note コールバックの中からこのキューの取り出し操作を呼び出してはいけません。
+     */
+    template <typename Callback>
+    Size consume(const Size& maxItems, Callback callback);
+
+    /**
+     * @brief キュー内の全てのデータを、取り出さずにその場でコールバックへ渡してから読み捨てる
+     *
+     * @tparam Callback `void(Element&)` として呼び出せる関数オブジェクト
+     * @param callback 各データに対して呼び出すコールバック
+     * @return Size 処理したデータの数
+     */
+    template <typename Callback>
+    Size consumeAll(Callback callback) {
+        return consume(internalDataSize, callback);
+    }
 
     /**
      * @brief キューの全体長を返す
      *
      * @return buffer_size_t キュー長
      */
-    Size capacity() const {
+    constexpr Size capacity() const {
         return internalDataSize;
     }
 
@@ -90,8 +135,8 @@ class Queue {
      *
      * @return buffer_size_t キュー内に存在するデータの数
      */
-    Size amount() const {
-        return count;
+    constexpr Size amount() const {
+        return cursor.amount(internalDataSize);
     }
 
     /**
@@ -99,8 +144,8 @@ class Queue {
      *
      * @return bool
      */
-    bool hasSpace() const {
-        return count < internalDataSize;
+    constexpr bool hasSpace() const {
+        return amount() < internalDataSize;
     }
 
     /**
@@ -108,60 +153,99 @@ class Queue {
      *
      * @return bool
      */
-    bool isEmpty() const {
-        return count == 0;
+    constexpr bool isEmpty() const {
+        return amount() == 0;
     }
 };
 
-template <typename Element, typename Size>
-Queue<Element, Size>::Queue(Element* const data, const Size& dataSize) : internalData(data) {
-    // ゼロ長のキューなら何もしない
-    if (dataSize == 0) {
-        internalDataSize = dataSize;
-        return;
-    }
+template <typename Element, typename Size, typename Policy, typename Indexing>
+constexpr Queue<Element, Size, Policy, Indexing>::Queue(Element* const data, const Size& dataSize)
+    : internalData(data), internalDataSize(Indexing::capacityOf(dataSize)){};
 
-    // 与えられたサイズを上回らない最大の2の冪数を探す
-    unsigned char maxbitPos = 0;
-    Size size = dataSize;
-    while ((size >>= 1) != 0) {
-        maxbitPos++;
-    }
-    internalDataSize = 1 << maxbitPos;
-};
-
-template <typename Element, typename Size>
-OperationResult Queue<Element, Size>::enqueue(const Element& data) {
+template <typename Element, typename Size, typename Policy, typename Indexing>
+COLLECTION2_CONSTEXPR14 OperationResult Queue<Element, Size, Policy, Indexing>::enqueue(const Element& data) {
     // キューがいっぱいなら戻る
     if (!hasSpace()) {
         return OperationResult::Overflow;
     }
 
     // tailの位置にデータを書き込む
-    *(internalData + tail) = data;
+    *(internalData + cursor.tailSlot(internalDataSize)) = data;
 
-    tail = (tail + 1) & (internalDataSize - 1);
-    count++;
+    cursor.pushed(static_cast<Size>(1), internalDataSize);
 
     return OperationResult::Success;
 }
 
-template <typename Element, typename Size>
-OperationResult Queue<Element, Size>::dequeue(Element* const data) {
+template <typename Element, typename Size, typename Policy, typename Indexing>
+COLLECTION2_CONSTEXPR14 OperationResult Queue<Element, Size, Policy, Indexing>::dequeue(Element* const data) {
     // キューが空なら戻る
     if (isEmpty()) {
         return OperationResult::Empty;
     }
 
     // 読み出して渡す
-    *data = *(internalData + head);
+    *data = *(internalData + cursor.headSlot(internalDataSize));
+
+    cursor.popped(static_cast<Size>(1), internalDataSize);
+
+    return OperationResult::Success;
+}
+
+template <typename Element, typename Size, typename Policy, typename Indexing>
+OperationResult Queue<Element, Size, Policy, Indexing>::enqueueN(const Element* const data, const Size& length) {
+    // 空きが足りなければ戻る
+    if (internalDataSize - amount() < length) {
+        return OperationResult::Overflow;
+    }
+
+    // 折り返し位置までと、先頭からの残りに分けて書き込む
+    const Size position = cursor.tailSlot(internalDataSize);
+    const Size untilWrap = internalDataSize - position;
+    const Size firstLength = length < untilWrap ? length : untilWrap;
+    internal::copyElements(internalData + position, data, firstLength);
+    internal::copyElements(internalData, data + firstLength, length - firstLength);
 
-    head = (head + 1) & (internalDataSize - 1);
-    count--;
+    cursor.pushed(length, internalDataSize);
 
     return OperationResult::Success;
 }
 
+template <typename Element, typename Size, typename Policy, typename Indexing>
+OperationResult Queue<Element, Size, Policy, Indexing>::dequeueN(Element* const data, const Size& length) {
+    // データが足りなければ戻る
+    if (amount() < length) {
+        return OperationResult::Empty;
+    }
+
+    // 折り返し位置までと、先頭からの残りに分けて読み出す
+    const Size position = cursor.headSlot(internalDataSize);
+    const Size untilWrap = internalDataSize - position;
+    const Size firstLength = length < untilWrap ? length : untilWrap;
+    internal::copyElements(data, internalData + position, firstLength);
+    internal::copyElements(data + firstLength, internalData, length - firstLength);
+
+    cursor.popped(length, internalDataSize);
+
+    return OperationResult::Success;
+}
+
+template <typename Element, typename Size, typename Policy, typename Indexing>
+template <typename Callback>
+Size Queue<Element, Size, Policy, Indexing>::consume(const Size& maxItems, Callback callback) {
+    const Size available = amount();
+    const Size length = available < maxItems ? available : maxItems;
+    Size position = cursor.headSlot(internalDataSize);
+    for (Size i = 0; i < length; i++) {
+        callback(*(internalData + position));
+        position = Indexing::advance(position, static_cast<Size>(1), internalDataSize);
+    }
+
+    cursor.popped(length, internalDataSize);
+
+    return length;
+}
+
 }  // namespace collection2
 
 #endif
@@ -0,0 +1,387 @@
+//
+// 基数木 (パトリシア木)
+//
+
+#ifndef COLLECTION2_RADIX_TRIE_H
+#define COLLECTION2_RADIX_TRIE_H
+
+#include <stddef.h>
+#include <string.h>
+
+#include "common.hpp"
+#include "pool.hpp"
+
+namespace collection2 {
+
+/**
+ * @brief 基数木の各ノードを表す構造体
+ *
+ * @tparam Value 値の型
+ * @tparam Size 要素数の型
+ *
+ * @note 子ノードは最初の子と次の兄弟へのリンクで表します (left-child/right-sibling)。
+ */
+template <typename Value, typename Size = size_t>
+struct RadixTrieNode {
+    // 親からこのノードへの辺のラベル (挿入時に渡されたキー文字列の一部を指す)
+    const char* label = nullptr;
+
+    // ラベルの長さ
+    Size labelLength = 0;
+
+    // 最初の子ノードへのポインタ
+    RadixTrieNode* child = nullptr;
+
+    // 次の兄弟ノードへのポインタ
+    RadixTrieNode* sibling = nullptr;
+
+    // ノードが持つ値
+    Value value = Value();
+
+    // このノードで終わるキーが存在するか
+    bool hasValue = false;
+};
+
+/**
+ * @brief 文字列をキーとする基数木 (パトリシア木)
+ *
+ * @tparam Value 値の型
+ * @tparam Size 要素数の型
+ *
+ * @note 共通の接頭辞を一つの辺にまとめるため、探索・挿入・最長一致はいずれもキーの長さに比例する時間で完了します。
+ * @note ノードのラベルはキー文字列を複製せずに直接参照します。挿入したキーは基数木を使い終わるまで有効である必要があります(文字列リテラルなど)。
+ */
+template <typename Value, typename Size = size_t>
+class RadixTrie {
+   private:
+    /**
+     * @brief ノードプール
+     */
+    Pool<RadixTrieNode<Value, Size>, Size> nodePool;
+
+    /**
+     * @brief 根ノード (空のキーに対応する)
+     */
+    RadixTrieNode<Value, Size> root;
+
+    /**
+     * @brief 格納されているキーの数
+     */
+    Size count = 0;
+
+    /**
+     * @brief 先頭の文字が一致する子ノードを探す
+     *
+     * @param node 親ノード
+     * @param first 探す文字
+     * @return RadixTrieNode<Value, Size>* 見つかった子ノード (なければnullptr)
+     */
+    static RadixTrieNode<Value, Size>* findChild(const RadixTrieNode<Value, Size>* node, const char first);
+
+    /**
+     * @brief ラベルとキーの共通接頭辞の長さを求める
+     *
+     * @param node 対象のノード
+     * @param key キー
+     * @param length キーの残りの長さ
+     * @return Size 共通接頭辞の長さ
+     */
+    static Size commonPrefixLength(const RadixTrieNode<Value, Size>* node, const char* key, const Size& length);
+
+   public:
+    /**
+     * @brief 内部データを扱う領域とそのサイズを指定して基数木を初期化
+     *
+     * @param data 内部データ保管用領域
+     * @param dataSize 領域サイズ
+     * @note 一つのキーの挿入には最大2つのノードを使用します。
+     */
+    RadixTrie(RadixTrieNode<Value, Size>* const data, const Size& dataSize) : nodePool(data, dataSize){};
+
+    RadixTrie(const RadixTrie&) = delete;
+    RadixTrie& operator=(const RadixTrie&) = delete;
+
+    ~RadixTrie() = default;
+
+    /**
+     * @brief キーと値を挿入する
+     *
+     * @param key キー (基数木を使い終わるまで有効である必要があります)
+     * @param length キーの長さ
+     * @param value 値
+     * @return OperationResult 操作結果
+     *
+     * @note すでに同じキーが存在する場合は値を上書きします。
+     * @note ノードが足りない場合は何も変更せずにOverflowを返します。
+     */
+    OperationResult insert(const char* key, const Size& length, const Value& value);
+
+    /**
+     * @brief NUL終端されたキーと値を挿入する
+     *
+     * @param key キー (基数木を使い終わるまで有効である必要があります)
+     * @param value 値
+     * @return OperationResult 操作結果
+     */
+    OperationResult insert(const char* key, const Value& value) {
+        return insert(key, static_cast<Size>(strlen(key)), value);
+    }
+
+    /**
+     * @brief キーに完全に一致する値を探す
+     *
+     * @param key キー
+     * @param length キーの長さ
+     * @return const Value* 見つかった値へのポインタ (なければnullptr)
+     */
+    const Value* find(const char* key, const Size& length) const;
+
+    /**
+     * @brief キーに完全に一致する値を探す
+     *
+     * @param key キー
+     * @param length キーの長さ
+     * @return Value* 見つかった値へのポインタ (なければnullptr)
+     */
+    Value* find(const char* key, const Size& length) {
+        return const_cast<Value*>(static_cast<const RadixTrie*>(this)->find(key, length));
+    }
+
+    /**
+     * @brief NUL終端されたキーに完全に一致する値を探す
+     *
+     * @param key キー
+     * @return Value* 見つかった値へのポインタ (なければnullptr)
+     */
+    Value* find(const char* key) {
+        return find(key, static_cast<Size>(strlen(key)));
+    }
+
+    /**
+     * @brief NUL終端されたキーに完全に一致する値を探す
+     *
+     * @param key キー
+     * @return const Value* 見つかった値へのポインタ (なければnullptr)
+     */
+    const Value* find(const char* key) const {
+        return find(key, static_cast<Size>(strlen(key)));
+    }
+
+    /**
+     * @brief 格納されたキーのうち、与えられた文字列の接頭辞となる最も長いものを探す
+     *
+     * @param key 探索する文字列
+     * @param length 文字列の長さ
+     * @param matchedLength 一致したキーの長さの格納先 (nullptrなら格納しない)
+     * @return const Value* 見つかった値へのポインタ (なければnullptr)
+     */
+    const Value* longestPrefix(const char* key, const Size& length, Size* const matchedLength = nullptr) const;
+
+    /**
+     * @brief 格納されたキーのうち、与えられた文字列の接頭辞となる最も長いものを探す
+     *
+     * @param key 探索する文字列
+     * @param length 文字列の長さ
+     * @param matchedLength 一致したキーの長さの格納先 (nullptrなら格納しない)
+     * @return Value* 見つかった値へのポインタ (なければnullptr)
+     */
+    Value* longestPrefix(const char* key, const Size& length, Size* const matchedLength = nullptr) {
+        return const_cast<Value*>(static_cast<const RadixTrie*>(this)->longestPrefix(key, length, matchedLength));
+    }
+
+    /**
+     * @brief 格納されたキーのうち、NUL終端された文字列の接頭辞となる最も長いものを探す
+     *
+     * @param key 探索する文字列
+     * @param matchedLength 一致したキーの長さの格納先 (nullptrなら格納しない)
+     * @return Value* 見つかった値へのポインタ (なければnullptr)
+     */
+    Value* longestPrefix(const char* key, Size* const matchedLength = nullptr) {
+        return longestPrefix(key, static_cast<Size>(strlen(key)), matchedLength);
+    }
+
+    /**
+     * @brief 格納されたキーのうち、NUL終端された文字列の接頭辞となる最も長いものを探す
+     *
+     * @param key 探索する文字列
+     * @param matchedLength 一致したキーの長さの格納先 (nullptrなら格納しない)
+     * @return const Value* 見つかった値へのポインタ (なければnullptr)
+     */
+    const Value* longestPrefix(const char* key, Size* const matchedLength = nullptr) const {
+        return longestPrefix(key, static_cast<Size>(strlen(key)), matchedLength);
+    }
+
+    /**
+     * @brief 全てのキーを削除する
+     */
+    void clear();
+
+    /**
+     * @brief 基数木が持てるノードの数を返す
+     *
+     * @return Size
+     */
+    Size capacity() const {
+        return nodePool.capacity();
+    }
+
+    /**
+     * @brief 格納されているキーの数を返す
+     *
+     * @return Size
+     */
+    Size amount() const {
+        return count;
+    }
+
+    /**
+     * @brief 基数木が空かどうか
+     *
+     * @return bool
+     */
+    bool isEmpty() const {
+        return count == 0;
+    }
+};
+
+template <typename Value, typename Size>
+RadixTrieNode<Value, Size>* RadixTrie<Value, Size>::findChild(const RadixTrieNode<Value, Size>* node, const char first) {
+    auto* child = node->child;
+    while (child != nullptr && child->label[0] != first) {
+        child = child->sibling;
+    }
+    return child;
+}
+
+template <typename Value, typename Size>
+Size RadixTrie<Value, Size>::commonPrefixLength(const RadixTrieNode<Value, Size>* node, const char* key, const Size& length) {
+    Size matched = 0;
+    while (matched < node->labelLength && matched < length && node->label[matched] == key[matched]) {
+        matched++;
+    }
+    return matched;
+}
+
+template <typename Value, typename Size>
+OperationResult RadixTrie<Value, Size>::insert(const char* key, const Size& length, const Value& value) {
+    auto* node = &root;
+    Size position = 0;
+
+    while (position < length) {
+        const Size remaining = length - position;
+        auto* child = findChild(node, key[position]);
+
+        // 一致する辺がなければ、残り全体をラベルとする葉を追加する
+        if (child == nullptr) {
+            auto* leaf = nodePool.acquire();
+            if (leaf == nullptr) {
+                return OperationResult::Overflow;
+            }
+            leaf->label = key + position;
+            leaf->labelLength = remaining;
+            leaf->value = value;
+            leaf->hasValue = true;
+            leaf->sibling = node->child;
+            node->child = leaf;
+            count++;
+            return OperationResult::Success;
+        }
+
+        // ラベル全体が一致すれば、その子へ進む
+        const Size matched = commonPrefixLength(child, key + position, remaining);
+        if (matched == child->labelLength) {
+            node = child;
+            position += matched;
+            continue;
+        }
+
+        // ラベルの途中で分かれるので、分岐点で辺を分割する
+        // キーが分岐点で終わらなければ、さらに葉が一つ必要になる
+        const Size required = matched == remaining ? 1 : 2;
+        if (nodePool.capacity() - nodePool.amount() < required) {
+            return OperationResult::Overflow;
+        }
+        auto* lower = nodePool.acquire();
+        lower->label = child->label + matched;
+        lower->labelLength = child->labelLength - matched;
+        lower->child = child->child;
+        lower->value = child->value;
+        lower->hasValue = child->hasValue;
+
+        child->labelLength = matched;
+        child->child = lower;
+        child->value = Value();
+        child->hasValue = false;
+
+        node = child;
+        position += matched;
+    }
+
+    // キーの終端に達したノードに値を設定する
+    if (!node->hasValue) {
+        count++;
+    }
+    node->value = value;
+    node->hasValue = true;
+    return OperationResult::Success;
+}
+
+template <typename Value, typename Size>
+const Value* RadixTrie<Value, Size>::find(const char* key, const Size& length) const {
+    const auto* node = &root;
+    Size position = 0;
+
+    while (position < length) {
+        const auto* child = findChild(node, key[position]);
+        if (child == nullptr || length - position < child->labelLength || memcmp(child->label, key + position, child->labelLength) != 0) {
+            return nullptr;
+        }
+        node = child;
+        position += child->labelLength;
+    }
+
+    return node->hasValue ? &node->value : nullptr;
+}
+
+template <typename Value, typename Size>
+const Value* RadixTrie<Value, Size>::longestPrefix(const char* key, const Size& length, Size* const matchedLength) const {
+    const auto* node = &root;
+    Size position = 0;
+    const RadixTrieNode<Value, Size>* found = root.hasValue ? &root : nullptr;
+    Size foundLength = 0;
+
+    // 辺のラベル全体が一致する限り降りていき、値を持つノードを記録する
+    while (position < length) {
+        const auto* child = findChild(node, key[position]);
+        if (child == nullptr || length - position < child->labelLength || memcmp(child->label, key + position, child->labelLength) != 0) {
+            break;
+        }
+        node = child;
+        position += child->labelLength;
+        if (node->hasValue) {
+            found = node;
+            foundLength = position;
+        }
+    }
+
+    if (found == nullptr) {
+        return nullptr;
+    }
+    if (matchedLength != nullptr) {
+        *matchedLength = foundLength;
+    }
+    return &found->value;
+}
+
+template <typename Value, typename Size>
+void RadixTrie<Value, Size>::clear() {
+    nodePool.reset();
+    root.child = nullptr;
+    root.value = Value();
+    root.hasValue = false;
+    count = 0;
+}
+
+}  // namespace collection2
+
+#endif
@@ -0,0 +1,416 @@
+//
+// スキップリスト
+//
+
+#ifndef COLLECTION2_SKIP_LIST_H
+#define COLLECTION2_SKIP_LIST_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "common.hpp"
+#include "pool.hpp"
+
+namespace collection2 {
+
+/**
+ * @brief スキップリストの要素を保持するノード
+ *
+ * @tparam Element 要素の型
+ * @tparam Size 要素数の型
+ */
+template <typename Element, typename Size = size_t>
+struct SkipListNode {
+    // 次のノードへのポインタ (昇順)
+    SkipListNode* next = nullptr;
+
+    // 要素
+    Element element = Element();
+};
+
+/**
+ * @brief スキップリストの索引 (各ノードの塔の一段)
+ *
+ * @tparam Element 要素の型
+ * @tparam Size 要素数の型
+ */
+template <typename Element, typename Size = size_t>
+struct SkipListIndex {
+    // 同じ段の次の索引へのポインタ
+    SkipListIndex* right = nullptr;
+
+    // 一つ下の段の索引へのポインタ (最下段ならnullptr)
+    SkipListIndex* down = nullptr;
+
+    // 索引が指すノード
+    SkipListNode<Element, Size>* node = nullptr;
+};
+
+/**
+ * @brief 要素を昇順に保持するスキップリスト
+ *
+ * @tparam Element 要素の型 (`<` で比較できる型)
+ * @tparam Size 要素数の型
+ * @tparam MaxLevel 塔の高さの上限 (最下段のリストを含む、2〜16)
+ *
+ * @note 要素を持つノードと、その上に積む索引をそれぞれ呼び出し側の領域から確保します。
+ *       塔の高さはノードごとに確率1/2で一段ずつ伸びるため、索引は平均してノードと同じ数だけ使用します。
+ *       索引が足りない場合は塔を低くして挿入を続けます(探索が遅くなるだけで、結果は変わりません)。
+ * @note 塔の高さは、libcに依存しない固定シードの擬似乱数(xorshift)で決めるため、同じ操作列に対して常に同じ構造になります。
+ * @note 探索・挿入・削除は期待 O(log n) で完了します。等しい要素は挿入した順に並びます。
+ */
+template <typename Element, typename Size = size_t, uint8_t MaxLevel = 12>
+class SkipList {
+    static_assert(MaxLevel >= 2 && MaxLevel <= 16, "collection2::SkipList: MaxLevel must be between 2 and 16");
+
+   private:
+    /**
+     * @brief ノードプール
+     */
+    Pool<SkipListNode<Element, Size>, Size> nodePool;
+
+    /**
+     * @brief 索引プール
+     */
+    Pool<SkipListIndex<Element, Size>, Size> indexPool;
+
+    /**
+     * @brief 最下段のリストの先頭
+     */
+    SkipListNode<Element, Size>* headPtr = nullptr;
+
+    /**
+     * @brief 各段の索引の先頭 (indexHeads[0]が最下段のすぐ上)
+     */
+    SkipListIndex<Element, Size>* indexHeads[MaxLevel - 1] = {};
+
+    /**
+     * @brief 使用中の索引の段数
+     */
+    uint8_t levels = 0;
+
+    /**
+     * @brief 擬似乱数の状態
+     */
+    uint16_t randomState;
+
+    /**
+     * @brief 格納されている要素の数
+     */
+    Size count = 0;
+
+    /**
+     * @brief 探索で要素より前に進むべきか
+     *
+     * @param candidate 候補の要素
+     * @param element 探索する要素
+     * @param inclusive 等しい要素も越えて進むか
+     * @return bool
+     */
+    static bool precedes(const Element& candidate, const Element& element, const bool inclusive) {
+        return inclusive ? !(element < candidate) : candidate < element;
+    }
+
+    /**
+     * @brief 各段で、要素より前にある最後の索引と最下段のノードを求める
+     *
+     * @param element 探索する要素
+     * @param inclusive 等しい要素も前にあるものとみなすか
+     * @param update 各段で見つかった索引の格納先 (先頭ならnullptr、不要ならupdate自体をnullptrにする)
+     * @return SkipListNode<Element, Size>* 最下段で要素より前にある最後のノード (先頭ならnullptr)
+     */
+    SkipListNode<Element, Size>* findPredecessor(const Element& element, const bool inclusive, SkipListIndex<Element, Size>** const update) const;
+
+    /**
+     * @brief ノードとその塔をリストから外して返却する
+     *
+     * @param predecessor 最下段で直前にあるノード (先頭ならnullptr)
+     * @param target 外すノード
+     * @param update 各段で直前にある索引
+     */
+    void unlink(SkipListNode<Element, Size>* const predecessor, SkipListNode<Element, Size>* const target, SkipListIndex<Element, Size>* const* const update);
+
+    /**
+     * @brief 新しいノードの索引の段数を決める
+     *
+     * @return uint8_t 索引の段数 (0なら最下段のみ)
+     */
+    uint8_t randomHeight();
+
+   public:
+    /**
+     * @brief ノード・索引を扱う領域とそのサイズを指定してスキップリストを初期化
+     *
+     * @param nodes ノード保管用領域
+     * @param nodeCount ノード領域のサイズ (格納できる要素の数)
+     * @param indices 索引保管用領域
+     * @param indexCount 索引領域のサイズ (要素数と同程度を推奨)
+     * @param seed 擬似乱数のシード (0以外)
+     */
+    constexpr SkipList(SkipListNode<Element, Size>* const nodes, const Size& nodeCount, SkipListIndex<Element, Size>* const indices, const Size& indexCount, const uint16_t seed = 0xACE1)
+        : nodePool(nodes, nodeCount), indexPool(indices, indexCount), randomState(seed != 0 ? seed : 0xACE1){};
+
+    SkipList(const SkipList&) = delete;
+    SkipList& operator=(const SkipList&) = delete;
+
+    ~SkipList() = default;
+
+    /**
+     * @brief 要素を順序を保って挿入する
+     *
+     * @param element 挿入する要素
+     * @return OperationResult 操作結果
+     * @note 等しい要素がすでにある場合は、その後ろに挿入します。
+     */
+    OperationResult insert(const Element& element);
+
+    /**
+     * @brief 要素に等しい最初の要素を削除する
+     *
+     * @param element 削除する要素
+     * @return OperationResult 操作結果 (見つからなければEmpty)
+     */
+    OperationResult remove(const Element& element);
+
+    /**
+     * @brief 最小の要素を取り出す
+     *
+     * @param element 取り出した要素の格納先 (nullptrなら読み捨てる)
+     * @return OperationResult 操作結果
+     */
+    OperationResult pop(Element* const element);
+
+    /**
+     * @brief 要素に等しい最初の要素を探す
+     *
+     * @param element 探す要素
+     * @return Element* 見つかった要素へのポインタ (なければnullptr)
+     * @note 順序が変わるような書き換えをしてはいけません。
+     */
+    Element* find(const Element& element) const;
+
+    /**
+     * @brief 要素以上の最初のノードを探す
+     *
+     * @param element 探す要素
+     * @return SkipListNode<Element, Size>* 見つかったノード (なければnullptr)
+     * @note 返されたノードから `next` をたどると、以降の要素を昇順に列挙できます。
+     */
+    SkipListNode<Element, Size>* lowerBound(const Element& element) const {
+        auto* predecessor = findPredecessor(element, false, nullptr);
+        return predecessor != nullptr ? predecessor->next : headPtr;
+    }
+
+    /**
+     * @brief 全ての要素を削除する
+     */
+    void clear();
+
+    /**
+     * @brief 最小の要素を持つノードへのポインタを取得
+     *
+     * @return SkipListNode<Element, Size>* 先頭のノード (空ならnullptr)
+     * @note `next` をたどると、全ての要素を昇順に列挙できます。
+     */
+    SkipListNode<Element, Size>* head() const {
+        return headPtr;
+    }
+
+    /**
+     * @brief スキップリストが持てる要素の数を返す
+     *
+     * @return Size
+     */
+    Size capacity() const {
+        return nodePool.capacity();
+    }
+
+    /**
+     * @brief 格納されている要素の数を返す
+     *
+     * @return Size
+     */
+    Size amount() const {
+        return count;
+    }
+
+    /**
+     * @brief スキップリストが空かどうか
+     *
+     * @return bool
+     */
+    bool isEmpty() const {
+        return count == 0;
+    }
+};
+
+template <typename Element, typename Size, uint8_t MaxLevel>
+SkipListNode<Element, Size>* SkipList<Element, Size, MaxLevel>::findPredecessor(const Element& element, const bool inclusive, SkipListIndex<Element, Size>** const update) const {
+    // 上の段から順に、進めるところまで進んでから一段下りる
+    SkipListIndex<Element, Size>* predecessor = nullptr;
+    for (uint8_t level = levels; level > 0; level--) {
+        auto* next = predecessor != nullptr ? predecessor->right : indexHeads[level - 1];
+        while (next != nullptr && precedes(next->node->element, element, inclusive)) {
+            predecessor = next;
+            next = next->right;
+        }
+        if (update != nullptr) {
+            update[level - 1] = predecessor;
+        }
+        if (level > 1 && predecessor != nullptr) {
+            predecessor = predecessor->down;
+        }
+    }
+
+    // 最下段のリストを進む
+    auto* node = predecessor != nullptr ? predecessor->node : nullptr;
+    auto* next = node != nullptr ? node->next : headPtr;
+    while (next != nullptr && precedes(next->element, element, inclusive)) {
+        node = next;
+        next = next->next;
+    }
+    return node;
+}
+
+template <typename Element, typename Size, uint8_t MaxLevel>
+void SkipList<Element, Size, MaxLevel>::unlink(SkipListNode<Element, Size>* const predecessor, SkipListNode<Element, Size>* const target, SkipListIndex<Element, Size>* const* const update) {
+    // 下の段から塔を外す 塔がない段より上に索引はない
+    for (uint8_t level = 1; level <= levels; level++) {
+        auto*& link = update[level - 1] != nullptr ? update[level - 1]->right : indexHeads[level - 1];
+        if (link == nullptr || link->node != target) {
+            break;
+        }
+        auto* index = link;
+        link = index->right;
+        indexPool.release(index);
+    }
+    while (levels > 0 && indexHeads[levels - 1] == nullptr) {
+        levels--;
+    }
+
+    if (predecessor != nullptr) {
+        predecessor->next = target->next;
+    } else {
+        headPtr = target->next;
+    }
+    nodePool.release(target);
+    count--;
+}
+
+template <typename Element, typename Size, uint8_t MaxLevel>
+uint8_t SkipList<Element, Size, MaxLevel>::randomHeight() {
+    // xorshift16
+    randomState ^= static_cast<uint16_t>(randomState << 7);
+    randomState ^= static_cast<uint16_t>(randomState >> 9);
+    randomState ^= static_cast<uint16_t>(randomState << 8);
+
+    // 下位ビットから1が続く数を高さとする (一度に増やす段数は一段まで)
+    const uint8_t limit = levels + 1 < MaxLevel - 1 ? levels + 1 : MaxLevel - 1;
+    uint16_t bits = randomState;
+    uint8_t height = 0;
+    while (height < limit && (bits & 1) != 0) {
+        height++;
+        bits >>= 1;
+    }
+    return height;
+}
+
+template <typename Element, typename Size, uint8_t MaxLevel>
+OperationResult SkipList<Element, Size, MaxLevel>::insert(const Element& element) {
+    SkipListIndex<Element, Size>* update[MaxLevel - 1];
+    auto* predecessor = findPredecessor(element, true, update);
+
+    auto* node = nodePool.acquire();
+    if (node == nullptr) {
+        return OperationResult::Overflow;
+    }
+    node->element = element;
+
+    // 最下段に挿入する
+    if (predecessor != nullptr) {
+        node->next = predecessor->next;
+        predecessor->next = node;
+    } else {
+        node->next = headPtr;
+        headPtr = node;
+    }
+    count++;
+
+    // 塔を積む 索引が足りなければそこで打ち切る
+    const uint8_t height = randomHeight();
+    SkipListIndex<Element, Size>* below = nullptr;
+    for (uint8_t level = 1; level <= height; level++) {
+        auto* index = indexPool.acquire();
+        if (index == nullptr) {
+            break;
+        }
+        if (level > levels) {
+            update[level - 1] = nullptr;
+            levels = level;
+        }
+
+        auto*& link = update[level - 1] != nullptr ? update[level - 1]->right : indexHeads[level - 1];
+        index->right = link;
+        index->down = below;
+        index->node = node;
+        link = index;
+        below = index;
+    }
+
+    return OperationResult::Success;
+}
+
+template <typename Element, typename Size, uint8_t MaxLevel>
+OperationResult SkipList<Element, Size, MaxLevel>::remove(const Element& element) {
+    SkipListIndex<Element, Size>* update[MaxLevel - 1];
+    auto* predecessor = findPredecessor(element, false, update);
+
+    // 直後のノードが要素以上で最初のもの
+    auto* target = predecessor != nullptr ? predecessor->next : headPtr;
+    if (target == nullptr || element < target->element) {
+        return OperationResult::Empty;
+    }
+
+    unlink(predecessor, target, update);
+    return OperationResult::Success;
+}
+
+template <typename Element, typename Size, uint8_t MaxLevel>
+OperationResult SkipList<Element, Size, MaxLevel>::pop(Element* const element) {
+    if (headPtr == nullptr) {
+        return OperationResult::Empty;
+    }
+    if (element != nullptr) {
+        *element = headPtr->element;
+    }
+
+    // 先頭のノードの直前は、どの段でも先頭
+    SkipListIndex<Element, Size>* const update[MaxLevel - 1] = {};
+    unlink(nullptr, headPtr, update);
+    return OperationResult::Success;
+}
+
+template <typename Element, typename Size, uint8_t MaxLevel>
+Element* SkipList<Element, Size, MaxLevel>::find(const Element& element) const {
+    auto* node = lowerBound(element);
+    if (node == nullptr || element < node->element) {
+        return nullptr;
+    }
+    return &node->element;
+}
+
+template <typename Element, typename Size, uint8_t MaxLevel>
+void SkipList<Element, Size, MaxLevel>::clear() {
+    nodePool.reset();
+    indexPool.reset();
+    headPtr = nullptr;
+    for (uint8_t level = 0; level < MaxLevel - 1; level++) {
+        indexHeads[level] = nullptr;
+    }
+    levels = 0;
+    count = 0;
+}
+
+}  // namespace collection2
+
+#endif
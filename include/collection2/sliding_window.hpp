@@ -0,0 +1,277 @@
+//
+// 集計値付きスライディングウィンドウ
+//
+
+#ifndef COLLECTION2_SLIDING_WINDOW_H
+#define COLLECTION2_SLIDING_WINDOW_H
+
+#include <stddef.h>
+
+#include "common.hpp"
+
+namespace collection2 {
+
+/**
+ * @brief スライディングウィンドウの各要素を保持する構造体
+ *
+ * @tparam Element 要素の型
+ * @tparam Size 要素数の型
+ *
+ * @note 要素そのものと、最小値・最大値の候補を管理する両端キューの各段をまとめて持ちます。
+ */
+template <typename Element, typename Size = size_t>
+struct SlidingWindowSlot {
+    // 要素
+    Element sample = Element();
+
+    // 最小値の候補となる要素の通し番号
+    Size minSequence = 0;
+
+    // 最大値の候補となる要素の通し番号
+    Size maxSequence = 0;
+};
+
+/**
+ * @brief 直近N個の要素の最小値・最大値・合計・平均を保持するリングバッファ
+ *
+ * @tparam Element 要素の型 (`<` で比較でき、`Accumulator` に加減算できる型)
+ * @tparam Size 要素数の型 (符号なし整数)
+ * @tparam Accumulator 合計値の型 (整数の要素で溢れる恐れがある場合は、より広い型を指定します)
+ *
+ * @note バッファ (`collection2::Buffer`) と同様、満杯の状態で追加すると最も古い要素が押し出されます。
+ * @note 合計は要素の出入りに合わせて加減算し、最小値・最大値は単調な両端キューで管理するため、追加はいずれも償却 O(1) で行われます。
+ * @note 合計は全体を計算し直さないため、浮動小数点数では加減算の丸め誤差が蓄積する点に注意してください。
+ */
+template <typename Element, typename Size = size_t, typename Accumulator = Element>
+class SlidingWindow {
+   private:
+    /**
+     * @brief 内部データ管理領域
+     */
+    SlidingWindowSlot<Element, Size>* const internalData;
+
+    /**
+     * @brief 内部データ長さ
+     */
+    Size internalDataSize;
+
+    /**
+     * @brief 最も古い要素の通し番号 (容量で丸めずに増え続ける)
+     */
+    Size head = 0;
+
+    /**
+     * @brief 次に追加する要素の通し番号 (容量で丸めずに増え続ける)
+     */
+    Size tail = 0;
+
+    /**
+     * @brief 最小値の候補を管理する両端キューの先頭と末尾
+     */
+    Size minHead = 0;
+    Size minTail = 0;
+
+    /**
+     * @brief 最大値の候補を管理する両端キューの先頭と末尾
+     */
+    Size maxHead = 0;
+    Size maxTail = 0;
+
+    /**
+     * @brief ウィンドウ内の要素の合計
+     */
+    Accumulator total = Accumulator();
+
+    /**
+     * @brief 通し番号に対応する領域を返す
+     *
+     * @param sequence 通し番号
+     * @return SlidingWindowSlot<Element, Size>&
+     */
+    SlidingWindowSlot<Element, Size>& slotAt(const Size& sequence) const {
+        return internalData[sequence & (internalDataSize - 1)];
+    }
+
+   public:
+    /**
+     * @brief 内部データを扱う領域とそのサイズを指定してウィンドウを初期化
+     *
+     * @param data 内部データ保管用領域
+     * @param dataSize 領域サイズ
+     * @note 領域サイズは2の冪乗であるべきです。それ以外の値を指定した場合、2の冪数のうち領域のサイズを下回らない最大のものが選択されます(15 -> 8, 34 -> 32).
+     */
+    constexpr SlidingWindow(SlidingWindowSlot<Element, Size>* const data, const Size& dataSize)
+        : internalData(data), internalDataSize(internal::floorPowerOfTwo(dataSize)){};
+
+    SlidingWindow(const SlidingWindow&) = delete;
+    SlidingWindow& operator=(const SlidingWindow&) = delete;
+
+    ~SlidingWindow() = default;
+
+    /**
+     * @brief ウィンドウの末尾に要素を追加
+     *
+     * @param data 追加する要素
+     * @return OperationResult 操作結果
+     * @note ウィンドウがいっぱいなら、最も古い要素を押し出してから追加します。
+     */
+    OperationResult append(const Element& data);
+
+    /**
+     * @brief ウィンドウの先頭 (最も古い要素) を取り出し
+     *
+     * @param data 取り出した要素の格納先 (nullptrなら読み捨てる)
+     * @return OperationResult 操作結果
+     */
+    OperationResult pop(Element* const data);
+
+    /**
+     * @brief 全ての要素を削除する
+     */
+    void clear();
+
+    /**
+     * @brief ウィンドウ内の最小値を返す
+     *
+     * @return const Element* 最小値へのポインタ (空ならnullptr)
+     */
+    const Element* minimum() const {
+        return isEmpty() ? nullptr : &slotAt(slotAt(minHead).minSequence).sample;
+    }
+
+    /**
+     * @brief ウィンドウ内の最大値を返す
+     *
+     * @return const Element* 最大値へのポインタ (空ならnullptr)
+     */
+    const Element* maximum() const {
+        return isEmpty() ? nullptr : &slotAt(slotAt(maxHead).maxSequence).sample;
+    }
+
+    /**
+     * @brief ウィンドウ内の要素の合計を返す
+     *
+     * @return Accumulator
+     */
+    constexpr Accumulator sum() const {
+        return total;
+    }
+
+    /**
+     * @brief ウィンドウ内の要素の平均を返す
+     *
+     * @return Accumulator 平均 (空なら `Accumulator()`)
+     * @note 整数型では切り捨てられます。
+     */
+    constexpr Accumulator mean() const {
+        return isEmpty() ? Accumulator() : total / static_cast<Accumulator>(amount());
+    }
+
+    /**
+     * @brief ウィンドウの全体長を返す
+     *
+     * @return Size ウィンドウ長
+     */
+    constexpr Size capacity() const {
+        return internalDataSize;
+    }
+
+    /**
+     * @brief 現在ウィンドウ内にある要素数を返す
+     *
+     * @return Size ウィンドウ内に存在する要素の数
+     */
+    constexpr Size amount() const {
+        return static_cast<Size>(tail - head);
+    }
+
+    /**
+     * @brief ウィンドウに要素を押し出さずに追加できるか
+     *
+     * @return bool
+     */
+    constexpr bool hasSpace() const {
+        return amount() < internalDataSize;
+    }
+
+    /**
+     * @brief ウィンドウが空かどうか
+     *
+     * @return bool
+     */
+    constexpr bool isEmpty() const {
+        return tail == head;
+    }
+};
+
+template <typename Element, typename Size, typename Accumulator>
+OperationResult SlidingWindow<Element, Size, Accumulator>::append(const Element& data) {
+    // サイズ0のウィンドウに要素を追加することはできない
+    if (internalDataSize == 0) {
+        return OperationResult::Overflow;
+    }
+
+    // ウィンドウがいっぱいなら、最も古い要素を押し出す
+    if (!hasSpace()) {
+        pop(nullptr);
+    }
+
+    slotAt(tail).sample = data;
+    total += data;
+
+    // 新しい要素以上の候補は二度と最小値にならないので、末尾から取り除いてから積む
+    while (minTail != minHead && !(slotAt(slotAt(minTail - 1).minSequence).sample < data)) {
+        minTail--;
+    }
+    slotAt(minTail).minSequence = tail;
+    minTail++;
+
+    // 最大値も同様
+    while (maxTail != maxHead && !(data < slotAt(slotAt(maxTail - 1).maxSequence).sample)) {
+        maxTail--;
+    }
+    slotAt(maxTail).maxSequence = tail;
+    maxTail++;
+
+    tail++;
+
+    return OperationResult::Success;
+}
+
+template <typename Element, typename Size, typename Accumulator>
+OperationResult SlidingWindow<Element, Size, Accumulator>::pop(Element* const data) {
+    // 空なら戻る
+    if (isEmpty()) {
+        return OperationResult::Empty;
+    }
+
+    const Element& oldest = slotAt(head).sample;
+    total -= oldest;
+    if (data != nullptr) {
+        *data = oldest;
+    }
+
+    // 押し出される要素が候補の先頭にあれば、候補からも取り除く
+    if (slotAt(minHead).minSequence == head) {
+        minHead++;
+    }
+    if (slotAt(maxHead).maxSequence == head) {
+        maxHead++;
+    }
+
+    head++;
+
+    return OperationResult::Success;
+}
+
+template <typename Element, typename Size, typename Accumulator>
+void SlidingWindow<Element, Size, Accumulator>::clear() {
+    head = tail = 0;
+    minHead = minTail = 0;
+    maxHead = maxTail = 0;
+    total = Accumulator();
+}
+
+}  // namespace collection2
+
+#endif
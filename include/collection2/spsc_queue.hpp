@@ -0,0 +1,229 @@
+//
+// 単一生産者・単一消費者キュー (ホスト環境のみ)
+//
+
+#ifndef COLLECTION2_SPSC_QUEUE_H
+#define COLLECTION2_SPSC_QUEUE_H
+
+#include <stddef.h>
+
+#include <atomic>
+
+#include "common.hpp"
+
+namespace collection2 {
+
+/**
+ * @brief 生産者スレッドと消費者スレッドの間で使う、ロックフリーのキュー
+ *
+ * @tparam Element
+ * @tparam Size 要素数の型 (符号なし整数)
+ *
+ * @note 生産者が書き換える状態と消費者が書き換える状態を別のキャッシュラインに置き、偽共有を防ぎます。
+ *       また、各々は相手のインデックスの古い写しを持ち、満杯・空に見えたときだけ相手のインデックスを読み直します。
+ * @note enqueueを呼ぶスレッド、dequeueを呼ぶスレッドはそれぞれ一つに限られます。
+ */
+template <typename Element, typename Size = size_t>
+class SpscQueue {
+   private:
+    /**
+     * @brief 内部データ管理領域
+     */
+    Element* const internalData;
+
+    /**
+     * @brief 内部データ長さ
+     */
+    Size internalDataSize;
+
+    /**
+     * @brief 生産者側の状態
+     */
+    struct alignas(COLLECTION2_CACHE_LINE_SIZE) ProducerState {
+        /// @brief キュー末尾 (容量で丸めずに増え続ける)
+        std::atomic<Size> tail;
+
+        /// @brief 最後に読んだ消費者側のhead
+        Size cachedHead;
+    } producer;
+
+    /**
+     * @brief 消費者側の状態
+     */
+    struct alignas(COLLECTION2_CACHE_LINE_SIZE) ConsumerState {
+        /// @brief キュー先頭 (容量で丸めずに増え続ける)
+        std::atomic<Size> head;
+
+        /// @brief 最後に読んだ生産者側のtail
+        Size cachedTail;
+    } consumer;
+
+   public:
+    /**
+     * @brief 内部データを扱う領域とそのサイズを指定してキューを初期化
+     *
+     * @param data 内部データ保管用領域
+     * @param dataSize 領域サイズ
+     * @note 領域サイズは2の冪乗であるべきです。それ以外の値を指定した場合、2の冪数のうち領域のサイズを下回らない最大のものが選択されます(15 -> 8, 34 -> 32).
+     */
+    SpscQueue(Element* const data, const Size& dataSize);
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    ~SpscQueue() = default;
+
+    /**
+     * @brief キューにデータを追加 (生産者スレッドから呼び出す)
+     *
+     * @param data 追加するデータ
+     * @return OperationResult 操作結果
+     */
+    OperationResult enqueue(const Element& data);
+
+    /**
+     * @brief キューからデータを取り出し (消費者スレッドから呼び出す)
+     *
+     * @param data 取り出したデータの格納先
+     * @return OperationResult 操作結果
+     */
+    OperationResult dequeue(Element* const data);
+
+    /**
+     * @brief キューの先頭から最大maxItems個のデータを、取り出さずにその場でコールバックへ渡してから読み捨てる (消費者スレッドから呼び出す)
+     *
+     * @tparam Callback `void(Element&)` として呼び出せる関数オブジェクト
+     * @param maxItems 処理するデータの最大数
+     * @param callback 各データに対して呼び出すコールバック
+     * @return Size 処理したデータの数
+     *
+     * @note 処理できる範囲を最初に一度だけ確定し、先頭の位置は最後に一度だけ更新します。
+     *       生産者側のtailの読み出し・headの公開はそれぞれ一度ずつになるため、相手のキャッシュラインへのアクセスをまとめて償却できます。
+     * @note コールバックの中からこのキューの取り出し操作を呼び出してはいけません。
+     */
+    template <typename Callback>
+    Size consume(const Size& maxItems, Callback callback);
+
+    /**
+     * @brief キュー内の全てのデータを、取り出さずにその場でコールバックへ渡してから読み捨てる (消費者スレッドから呼び出す)
+     *
+     * @tparam Callback `void(Element&)` として呼び出せる関数オブジェクト
+     * @param callback 各データに対して呼び出すコールバック
+     * @return Size 処理したデータの数
+     */
+    template <typename Callback>
+    Size consumeAll(Callback callback) {
+        return consume(internalDataSize, callback);
+    }
+
+    /**
+     * @brief キューの全体長を返す
+     *
+     * @return Size キュー長
+     */
+    Size capacity() const {
+        return internalDataSize;
+    }
+
+    /**
+     * @brief 現在キュー内にあるデータ数を返す
+     *
+     * @return Size キュー内に存在するデータの数
+     * @note 他方のスレッドが操作している間は、呼び出した時点での近似値となります。
+     */
+    Size amount() const {
+        const Size head = consumer.head.load(std::memory_order_acquire);
+        return producer.tail.load(std::memory_order_acquire) - head;
+    }
+
+    /**
+     * @brief キューに値を追加できるか
+     *
+     * @return bool
+     */
+    bool hasSpace() const {
+        return amount() < internalDataSize;
+    }
+
+    /**
+     * @brief キューが空かどうか
+     *
+     * @return bool
+     */
+    bool isEmpty() const {
+        return amount() == 0;
+    }
+};
+
+template <typename Element, typename Size>
+SpscQueue<Element, Size>::SpscQueue(Element* const data, const Size& dataSize)
+    : internalData(data), internalDataSize(internal::floorPowerOfTwo(dataSize)) {
+    producer.tail.store(0, std::memory_order_relaxed);
+    producer.cachedHead = 0;
+    consumer.head.store(0, std::memory_order_relaxed);
+    consumer.cachedTail = 0;
+};
+
+template <typename Element, typename Size>
+OperationResult SpscQueue<Element, Size>::enqueue(const Element& data) {
+    const Size tail = producer.tail.load(std::memory_order_relaxed);
+
+    // 満杯に見えたときだけ消費者側のheadを読み直す
+    if (static_cast<Size>(tail - producer.cachedHead) == internalDataSize) {
+        producer.cachedHead = consumer.head.load(std::memory_order_acquire);
+        if (static_cast<Size>(tail - producer.cachedHead) == internalDataSize) {
+            return OperationResult::Overflow;
+        }
+    }
+
+    // tailの位置にデータを書き込んでから公開する
+    *(internalData + (tail & (internalDataSize - 1))) = data;
+    producer.tail.store(tail + 1, std::memory_order_release);
+
+    return OperationResult::Success;
+}
+
+template <typename Element, typename Size>
+OperationResult SpscQueue<Element, Size>::dequeue(Element* const data) {
+    const Size head = consumer.head.load(std::memory_order_relaxed);
+
+    // 空に見えたときだけ生産者側のtailを読み直す
+    if (head == consumer.cachedTail) {
+        consumer.cachedTail = producer.tail.load(std::memory_order_acquire);
+        if (head == consumer.cachedTail) {
+            return OperationResult::Empty;
+        }
+    }
+
+    // 読み出してからheadを公開する
+    *data = *(internalData + (head & (internalDataSize - 1)));
+    consumer.head.store(head + 1, std::memory_order_release);
+
+    return OperationResult::Success;
+}
+
+template <typename Element, typename Size>
+template <typename Callback>
+Size SpscQueue<Element, Size>::consume(const Size& maxItems, Callback callback) {
+    const Size head = consumer.head.load(std::memory_order_relaxed);
+
+    // 処理できる範囲を一度だけ確定する
+    consumer.cachedTail = producer.tail.load(std::memory_order_acquire);
+    const Size available = consumer.cachedTail - head;
+    const Size length = available < maxItems ? available : maxItems;
+    if (length == 0) {
+        return 0;
+    }
+
+    // 全て処理してからheadを一度だけ公開する
+    for (Size i = 0; i < length; i++) {
+        callback(*(internalData + ((head + i) & (internalDataSize - 1))));
+    }
+    consumer.head.store(head + length, std::memory_order_release);
+
+    return length;
+}
+
+}  // namespace collection2
+
+#endif
@@ -6,6 +6,7 @@
 #define _COLLECTION2_STACK_H_
 
 #include <stddef.h>
+#include <stdint.h>
 
 #include "common.hpp"
 
@@ -42,7 +43,7 @@ class Stack {
      * @param data 内部データ保管用領域
      * @param dataSize 領域サイズ
      */
-    Stack(Element* const data, const Size& dataSize);
+    constexpr Stack(Element* const data, const Size& dataSize);
 
     Stack(const Stack&) = delete;
     Stack& operator=(const Stack&) = delete;
@@ -55,7 +56,7 @@ class Stack {
      * @param data 追加するデータ
      * @return OperationResult 操作結果
      */
-    OperationResult push(const Element& data);
+    COLLECTION2_CONSTEXPR14 OperationResult push(const Element& data);
 
     /**
      * @brief スタックからデータを取り出し
@@ -63,14 +64,56 @@ class Stack {
      * @param data 取り出したデータの格納先
      * @return OperationResult 操作結果
      */
-    OperationResult pop(Element* const data);
+    COLLECTION2_CONSTEXPR14 OperationResult pop(Element* const data);
+
+    /**
+     * @brief スタックに複数のデータをまとめて追加
+     *
+     * @param data 追加するデータの配列 (末尾の要素がスタックの先頭になる)
+     * @param length 追加するデータの数
+     * @return OperationResult 操作結果
+     *
+     * @note 空きが足りない場合は何も追加せずにOverflowを返します。
+     */
+    OperationResult pushN(const Element* const data, const Size& length);
+
+    /**
+     * @brief スタックから複数のデータをまとめて取り出し
+     *
+     * @param data 取り出したデータの格納先 (積まれていた順に格納され、末尾の要素が元のスタックの先頭になる)
+     * @param length 取り出すデータの数
+     * @return OperationResult 操作結果
+     *
+     * @note データが足りない場合は何も取り出さずにEmptyを返します。
+     */
+    OperationResult popN(Element* const data, const Size& length);
+
+    /**
+     * @brief スタック先頭のデータを参照する
+     *
+     * @return Element* 先頭のデータへのポインタ
+     * @note スタックが空の場合はnullptrが返ります。
+     */
+    COLLECTION2_CONSTEXPR14 Element* top() {
+        return isEmpty() ? nullptr : internalData + sp - 1;
+    }
+
+    /**
+     * @brief スタック先頭のデータを参照する
+     *
+     * @return const Element* 先頭のデータへのポインタ
+     * @note スタックが空の場合はnullptrが返ります。
+     */
+    constexpr const Element* top() const {
+        return isEmpty() ? nullptr : internalData + sp - 1;
+    }
 
     /**
      * @brief スタックの全体長を返す
      *
      * @return buffer_size_t スタック長
      */
-    Size capacity() const {
+    constexpr Size capacity() const {
         return internalDataSize;
     }
 
@@ -79,7 +122,7 @@ class Stack {
      *
      * @return buffer_size_t スタック内に存在するデータの数
      */
-    Size amount() const {
+    constexpr Size amount() const {
         return sp;
     }
 
@@ -88,7 +131,7 @@ class Stack {
      *
      * @return bool
      */
-    bool hasSpace() const {
+    constexpr bool hasSpace() const {
         return sp < internalDataSize;
     }
 
@@ -97,16 +140,16 @@ class Stack {
      *
      * @return bool
      */
-    bool isEmpty() const {
+    constexpr bool isEmpty() const {
         return sp == 0;
     }
 };
 
 template <typename Element, typename Size>
-Stack<Element, Size>::Stack(Element* const data, const Size& dataSize) : internalData(data), internalDataSize(dataSize){};
+constexpr Stack<Element, Size>::Stack(Element* const data, const Size& dataSize) : internalData(data), internalDataSize(dataSize){};
 
 template <typename Element, typename Size>
-OperationResult Stack<Element, Size>::push(const Element& data) {
+COLLECTION2_CONSTEXPR14 OperationResult Stack<Element, Size>::push(const Element& data) {
     // スタックがいっぱいなら戻る
     if (!hasSpace()) {
         return OperationResult::Overflow;
@@ -120,7 +163,7 @@ OperationResult Stack<Element, Size>::push(const Element& data) {
 }
 
 template <typename Element, typename Size>
-OperationResult Stack<Element, Size>::pop(Element* const data) {
+COLLECTION2_CONSTEXPR14 OperationResult Stack<Element, Size>::pop(Element* const data) {
     // スタックが空なら戻る
     if (isEmpty()) {
         return OperationResult::Empty;
@@ -132,6 +175,267 @@ OperationResult Stack<Element, Size>::pop(Element* const data) {
     return OperationResult::Success;
 }
 
+template <typename Element, typename Size>
+OperationResult Stack<Element, Size>::pushN(const Element* const data, const Size& length) {
+    // 空きが足りなければ戻る
+    if (internalDataSize - sp < length) {
+        return OperationResult::Overflow;
+    }
+
+    // spの位置からまとめて書き込んで進める
+    internal::copyElements(internalData + sp, data, length);
+    sp += length;
+
+    return OperationResult::Success;
+}
+
+template <typename Element, typename Size>
+OperationResult Stack<Element, Size>::popN(Element* const data, const Size& length) {
+    // データが足りなければ戻る
+    if (sp < length) {
+        return OperationResult::Empty;
+    }
+
+    // spを減らしてまとめて読み出す
+    sp -= length;
+    internal::copyElements(data, internalData + sp, length);
+
+    return OperationResult::Success;
+}
+
+/**
+ * @brief 両端スタックのどちら側か
+ */
+enum class DualStackSide : uint8_t {
+    /// @brief 領域の先頭から後ろへ伸びるスタック
+    Lower,
+
+    /// @brief 領域の末尾から前へ伸びるスタック
+    Upper
+};
+
+/**
+ * @brief 一つの領域を両端から共有する2本のスタック
+ *
+ * @tparam Element
+ * @tparam Size
+ *
+ * @note 2本のスタックの境界は固定されておらず、どちらか一方が領域全体を使うこともできます。
+ */
+template <typename Element, typename Size = size_t>
+class DualStack {
+   private:
+    /**
+     * @brief 内部データ管理領域
+     */
+    Element* const internalData;
+
+    /**
+     * @brief 内部データ長さ
+     */
+    Size internalDataSize;
+
+    /**
+     * @brief 下側スタックのスタックポインタ (次に書き込む位置)
+     */
+    Size lowerSp = 0;
+
+    /**
+     * @brief 上側スタックのスタックポインタ (最後に書き込んだ位置)
+     */
+    Size upperSp;
+
+   public:
+    /**
+     * @brief 内部データを扱う領域とそのサイズを指定して両端スタックを初期化
+     *
+     * @param data 内部データ保管用領域
+     * @param dataSize 領域サイズ
+     */
+    constexpr DualStack(Element* const data, const Size& dataSize);
+
+    DualStack(const DualStack&) = delete;
+    DualStack& operator=(const DualStack&) = delete;
+
+    ~DualStack() = default;
+
+    /**
+     * @brief スタックにデータを追加
+     *
+     * @param side 対象のスタック
+     * @param data 追加するデータ
+     * @return OperationResult 操作結果
+     */
+    OperationResult push(const DualStackSide side, const Element& data);
+
+    /**
+     * @brief スタックからデータを取り出し
+     *
+     * @param side 対象のスタック
+     * @param data 取り出したデータの格納先
+     * @return OperationResult 操作結果
+     */
+    OperationResult pop(const DualStackSide side, Element* const data);
+
+    /**
+     * @brief スタックに複数のデータをまとめて追加
+     *
+     * @param side 対象のスタック
+     * @param data 追加するデータの配列 (末尾の要素がスタックの先頭になる)
+     * @param length 追加するデータの数
+     * @return OperationResult 操作結果
+     *
+     * @note 空きが足りない場合は何も追加せずにOverflowを返します。
+     */
+    OperationResult pushN(const DualStackSide side, const Element* const data, const Size& length);
+
+    /**
+     * @brief スタックから複数のデータをまとめて取り出し
+     *
+     * @param side 対象のスタック
+     * @param data 取り出したデータの格納先 (積まれていた順に格納され、末尾の要素が元のスタックの先頭になる)
+     * @param length 取り出すデータの数
+     * @return OperationResult 操作結果
+     *
+     * @note データが足りない場合は何も取り出さずにEmptyを返します。
+     */
+    OperationResult popN(const DualStackSide side, Element* const data, const Size& length);
+
+    /**
+     * @brief スタック先頭のデータを参照する
+     *
+     * @param side 対象のスタック
+     * @return Element* 先頭のデータへのポインタ
+     * @note スタックが空の場合はnullptrが返ります。
+     */
+    Element* top(const DualStackSide side) {
+        if (isEmpty(side)) {
+            return nullptr;
+        }
+        return side == DualStackSide::Lower ? internalData + lowerSp - 1 : internalData + upperSp;
+    }
+
+    /**
+     * @brief 2本のスタックで共有している領域の全体長を返す
+     *
+     * @return Size 領域長
+     */
+    Size capacity() const {
+        return internalDataSize;
+    }
+
+    /**
+     * @brief 現在スタック内にあるデータ数を返す
+     *
+     * @param side 対象のスタック
+     * @return Size スタック内に存在するデータの数
+     */
+    Size amount(const DualStackSide side) const {
+        return side == DualStackSide::Lower ? lowerSp : internalDataSize - upperSp;
+    }
+
+    /**
+     * @brief 共有領域に値を追加できるか
+     *
+     * @return bool
+     */
+    bool hasSpace() const {
+        return lowerSp < upperSp;
+    }
+
+    /**
+     * @brief スタックが空かどうか
+     *
+     * @param side 対象のスタック
+     * @return bool
+     */
+    bool isEmpty(const DualStackSide side) const {
+        return amount(side) == 0;
+    }
+};
+
+template <typename Element, typename Size>
+constexpr DualStack<Element, Size>::DualStack(Element* const data, const Size& dataSize)
+    : internalData(data), internalDataSize(dataSize), upperSp(dataSize){};
+
+template <typename Element, typename Size>
+OperationResult DualStack<Element, Size>::push(const DualStackSide side, const Element& data) {
+    // 2本のスタックが衝突するなら戻る
+    if (!hasSpace()) {
+        return OperationResult::Overflow;
+    }
+
+    // 下側は前から、上側は後ろから書き込む
+    if (side == DualStackSide::Lower) {
+        *(internalData + lowerSp) = data;
+        lowerSp++;
+    } else {
+        upperSp--;
+        *(internalData + upperSp) = data;
+    }
+
+    return OperationResult::Success;
+}
+
+template <typename Element, typename Size>
+OperationResult DualStack<Element, Size>::pop(const DualStackSide side, Element* const data) {
+    // スタックが空なら戻る
+    if (isEmpty(side)) {
+        return OperationResult::Empty;
+    }
+
+    if (side == DualStackSide::Lower) {
+        lowerSp--;
+        *data = *(internalData + lowerSp);
+    } else {
+        *data = *(internalData + upperSp);
+        upperSp++;
+    }
+
+    return OperationResult::Success;
+}
+
+template <typename Element, typename Size>
+OperationResult DualStack<Element, Size>::pushN(const DualStackSide side, const Element* const data, const Size& length) {
+    // 空きが足りなければ戻る
+    if (upperSp - lowerSp < length) {
+        return OperationResult::Overflow;
+    }
+
+    if (side == DualStackSide::Lower) {
+        internal::copyElements(internalData + lowerSp, data, length);
+        lowerSp += length;
+    } else {
+        // 上側は領域の後ろから前へ伸びるため、並びは逆になる
+        for (Size i = 0; i < length; i++) {
+            *(internalData + upperSp - 1 - i) = data[i];
+        }
+        upperSp -= length;
+    }
+
+    return OperationResult::Success;
+}
+
+template <typename Element, typename Size>
+OperationResult DualStack<Element, Size>::popN(const DualStackSide side, Element* const data, const Size& length) {
+    // データが足りなければ戻る
+    if (amount(side) < length) {
+        return OperationResult::Empty;
+    }
+
+    if (side == DualStackSide::Lower) {
+        lowerSp -= length;
+        internal::copyElements(data, internalData + lowerSp, length);
+    } else {
+        for (Size i = 0; i < length; i++) {
+            data[i] = *(internalData + upperSp + length - 1 - i);
+        }
+        upperSp += length;
+    }
+
+    return OperationResult::Success;
+}
+
 }  // namespace collection2
 
 #endif
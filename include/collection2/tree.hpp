@@ -9,20 +9,207 @@
 #include <stdint.h>
 
 #include "common.hpp"
+#include "pool.hpp"
 
 namespace collection2 {
 
+/**
+ * @brief ツリーノードの付加情報: なし
+ */
+struct NoAugmentation {};
+
+/**
+ * @brief ツリーノードの付加情報: 部分木のノード数 (`subtreeSize`)
+ *
+ * @note 中間順での順位を求める操作 (`Tree::select`, `Tree::rank`, `Tree::countLess`) が O(高さ) で行えるようになります。
+ */
+struct SubtreeSize {};
+
+/**
+ * @brief ツリーノードの付加情報: 部分木のノード数と、部分木の要素をモノイドで畳み込んだ値 (`aggregate`)
+ *
+ * @tparam Monoid 次のメンバを持つ型
+ *         - `Value`: 畳み込んだ値の型
+ *         - `static Value identity()`: 単位元
+ *         - `static Value of(const Element&)`: 要素一つの値
+ *         - `static Value combine(const Value& lhs, const Value& rhs)`: 結合的な二項演算 (左の部分木, 自身, 右の部分木の順に適用されます)
+ */
+template <typename Monoid>
+struct SubtreeAggregate {};
+
+namespace internal {
+
+/**
+ * @brief ツリーノードの親へのリンク (持たない場合)
+ *
+ * @tparam Node ノードの型
+ * @tparam ParentLinked 親へのリンクを持つか
+ */
+template <typename Node, bool ParentLinked>
+struct TreeNodeParentLink {
+    constexpr TreeNodeParentLink(Node* const = nullptr) {}
+
+    /**
+     * @brief 親ノードを返す
+     *
+     * @return Node* 常にnullptr
+     */
+    constexpr Node* parentNode() const {
+        return nullptr;
+    }
+
+    /**
+     * @brief 親ノードを設定する (何もしない)
+     */
+    void linkParent(Node* const) {}
+};
+
+/**
+ * @brief ツリーノードの親へのリンク (持つ場合)
+ *
+ * @tparam Node ノードの型
+ */
+template <typename Node>
+struct TreeNodeParentLink<Node, true> {
+    // 親ノードへのポインタ
+    Node* parent = nullptr;
+
+    constexpr TreeNodeParentLink(Node* const node = nullptr) : parent(node) {}
+
+    /**
+     * @brief 親ノードを返す
+     *
+     * @return Node* 親ノード (根ならnullptr)
+     */
+    constexpr Node* parentNode() const {
+        return parent;
+    }
+
+    /**
+     * @brief 親ノードを設定する
+     *
+     * @param node 親ノード
+     */
+    void linkParent(Node* const node) {
+        parent = node;
+    }
+};
+
+/**
+ * @brief ツリーノードの付加情報 (持たない場合)
+ *
+ * @tparam Node ノードの型
+ * @tparam Size 要素数の型
+ * @tparam Augmentation 付加情報の種類
+ */
+template <typename Node, typename Size, typename Augmentation>
+struct TreeNodeAugmentation {
+    static constexpr bool augmented = false;
+
+    /**
+     * @brief ノードの付加情報を子から計算し直す (何もしない)
+     */
+    static void refresh(Node* const) {}
+
+    /**
+     * @brief ノードから根までの付加情報を計算し直す (何もしない)
+     */
+    static void refreshPath(Node* const) {}
+};
+
+/**
+ * @brief ツリーノードの付加情報 (部分木のノード数)
+ *
+ * @tparam Node ノードの型
+ * @tparam Size 要素数の型
+ */
+template <typename Node, typename Size>
+struct TreeNodeAugmentation<Node, Size, SubtreeSize> {
+    static constexpr bool augmented = true;
+
+    // 自身を含む部分木のノード数
+    Size subtreeSize = 1;
+
+    /**
+     * @brief 部分木のノード数を返す
+     *
+     * @param node 部分木の根
+     * @return Size ノード数 (nullptrなら0)
+     */
+    static Size sizeOf(const Node* const node) {
+        return node != nullptr ? node->subtreeSize : 0;
+    }
+
+    /**
+     * @brief ノードの付加情報を子から計算し直す
+     *
+     * @param node 対象のノード
+     */
+    static void refresh(Node* const node) {
+        node->subtreeSize = static_cast<Size>(1 + sizeOf(node->lhs) + sizeOf(node->rhs));
+    }
+
+    /**
+     * @brief ノードから根までの付加情報を計算し直す
+     *
+     * @param node 起点のノード (nullptrなら何もしない)
+     */
+    static void refreshPath(Node* node) {
+        while (node != nullptr) {
+            Node::refresh(node);
+            node = node->parentNode();
+        }
+    }
+};
+
+/**
+ * @brief ツリーノードの付加情報 (部分木のノード数と、モノイドで畳み込んだ値)
+ *
+ * @tparam Node ノードの型
+ * @tparam Size 要素数の型
+ * @tparam Monoid モノイド
+ */
+template <typename Node, typename Size, typename Monoid>
+struct TreeNodeAugmentation<Node, Size, SubtreeAggregate<Monoid>> : public TreeNodeAugmentation<Node, Size, SubtreeSize> {
+    // 部分木の要素を中間順に畳み込んだ値
+    typename Monoid::Value aggregate = Monoid::identity();
+
+    /**
+     * @brief 部分木を畳み込んだ値を返す
+     *
+     * @param node 部分木の根
+     * @return typename Monoid::Value 畳み込んだ値 (nullptrなら単位元)
+     */
+    static typename Monoid::Value aggregateOf(const Node* const node) {
+        return node != nullptr ? node->aggregate : Monoid::identity();
+    }
+
+    /**
+     * @brief ノードの付加情報を子から計算し直す
+     *
+     * @param node 対象のノード
+     */
+    static void refresh(Node* const node) {
+        TreeNodeAugmentation<Node, Size, SubtreeSize>::refresh(node);
+        node->aggregate = Monoid::combine(Monoid::combine(aggregateOf(node->lhs), Monoid::of(node->element)), aggregateOf(node->rhs));
+    }
+};
+
+}  // namespace internal
+
 /**
  * @brief ツリーの各ノードを表す構造体
  *
  * @tparam Element 要素の型
  * @tparam Size 要素数の型
+ * @tparam ParentLinked 親ノードへのポインタ (`parent`) を持つか
+ * @tparam Augmentation 付加情報の種類 (`NoAugmentation`, `SubtreeSize`, `SubtreeAggregate`)
+ *
+ * @note 親へのリンクや付加情報を持たない場合、ノードの大きさは増えません。
  */
-template <typename Element, typename Size = size_t>
-struct TreeNode {
-    // 有効なノードか
-    bool isEnabled = false;
-
+template <typename Element, typename Size = size_t, bool ParentLinked = false, typename Augmentation = NoAugmentation>
+struct TreeNode : public internal::TreeNodeParentLink<TreeNode<Element, Size, ParentLinked, Augmentation>, ParentLinked>,
+                  public internal::TreeNodeAugmentation<TreeNode<Element, Size, ParentLinked, Augmentation>, Size, Augmentation> {
     // 左側子ノードへのポインタ
     TreeNode* lhs = nullptr;
 
@@ -30,14 +217,29 @@ struct TreeNode {
     TreeNode* rhs = nullptr;
 
     // ノードが持つ要素
-    Element element;
+    Element element = Element();
+
+    TreeNode() = default;
+
+    /**
+     * @brief 値と子ノードを指定してノードを構築する
+     *
+     * @param value ノードが持つ要素
+     * @param left 左側子ノード
+     * @param right 右側子ノード
+     * @param up 親ノード (親へのリンクを持たない場合は無視されます)
+     * @note 静的なノード配列の初期化子として使用すると、構築済みのツリーをそのまま配置できます。
+     *       付加情報を持つ場合は、配置後に `Tree::rebuildAugmentation` で計算してください。
+     */
+    constexpr TreeNode(const Element& value, TreeNode* left = nullptr, TreeNode* right = nullptr, TreeNode* up = nullptr)
+        : internal::TreeNodeParentLink<TreeNode, ParentLinked>(up), lhs(left), rhs(right), element(value) {}
 
     /**
      * @brief リーフかどうかを調べる
      *
      * @return bool
      */
-    bool isLeaf() const {
+    constexpr bool isLeaf() const {
         return (lhs == nullptr) && (rhs == nullptr);
     };
 };
@@ -53,33 +255,252 @@ enum class TreeNodeSide : uint8_t {
     Right
 };
 
+template <typename Element, typename Size, bool ParentLinked, typename Augmentation, typename Policy>
+class Tree;
+
 /**
- * @brief ツリー
+ * @brief 二分探索木を幅優先順の暗黙的配列 (Eytzinger配列) に並べ直した、読み取り専用の探索構造
  *
  * @tparam Element 要素の型
  * @tparam Size 要素数の型
+ *
+ * @note `Tree::freeze` により構築します。
+ *       ノード k の子は 2k, 2k+1 番目 (1始まり) に置かれるため、探索はポインタを辿らず、上位の段ほど同じキャッシュラインに集まります。
  */
 template <typename Element, typename Size = size_t>
-class Tree {
+class FrozenTree {
+    template <typename, typename, bool, typename, typename>
+    friend class Tree;
+
    private:
     /**
      * @brief 内部データ管理領域
      */
-    TreeNode<Element>* const internalData;
+    Element* const internalData;
 
     /**
      * @brief 内部データ長さ
      */
     Size internalDataSize;
 
+    /**
+     * @brief 格納されている要素数
+     */
+    Size count = 0;
+
+    /**
+     * @brief 部分木のノード数を数える
+     *
+     * @param node 部分木の根
+     * @return Size ノード数
+     */
+    template <typename Node>
+    static Size countNodes(const Node* node);
+
+    /**
+     * @brief 部分木を中間順に辿り、暗黙的配列の中間順の位置へ書き出す
+     *
+     * @param node 部分木の根
+     * @param position 次に書き込む位置 (1始まり)
+     */
+    template <typename Node>
+    void layout(const Node* node, size_t& position);
+
+    /**
+     * @brief 暗黙的配列上で、中間順の次の位置を返す
+     *
+     * @param position 現在の位置 (1始まり)
+     * @return size_t 次の位置 (末尾を超えた場合は0)
+     */
+    size_t nextInOrder(size_t position) const;
+
+    /**
+     * @brief key以上の最初の要素の位置を探す
+     *
+     * @param key 探索キー
+     * @param compare 比較関数
+     * @return size_t 見つかった位置 (1始まり、見つからなければ0)
+     */
+    template <typename Compare>
+    size_t search(const Element& key, Compare compare) const;
+
+   public:
+    /**
+     * @brief 内部データを扱う領域とそのサイズを指定して初期化
+     *
+     * @param data 内部データ保管用領域
+     * @param dataSize 領域サイズ
+     */
+    constexpr FrozenTree(Element* const data, const Size& dataSize) : internalData(data), internalDataSize(dataSize){};
+
+    FrozenTree(const FrozenTree&) = delete;
+    FrozenTree& operator=(const FrozenTree&) = delete;
+
+    ~FrozenTree() = default;
+
+    /**
+     * @brief key以上の最初の要素を探す
+     *
+     * @tparam Compare 比較関数の型
+     * @param key 探索キー
+     * @param compare 比較関数 `bool(const Element& lhs, const Element& rhs)`。元のツリーの左右の順序と一致している必要があります
+     * @return const Element* 見つかった要素へのポインタ (全ての要素がkeyより小さければnullptr)
+     */
+    template <typename Compare>
+    const Element* lowerBound(const Element& key, Compare compare) const {
+        const size_t position = search(key, compare);
+        return position == 0 ? nullptr : internalData + position - 1;
+    }
+
+    /**
+     * @brief `operator<` の順序で、key以上の最初の要素を探す
+     *
+     * @param key 探索キー
+     * @return const Element* 見つかった要素へのポインタ (全ての要素がkeyより小さければnullptr)
+     */
+    const Element* lowerBound(const Element& key) const {
+        return lowerBound(key, [](const Element& lhs, const Element& rhs) { return lhs < rhs; });
+    }
+
+    /**
+     * @brief keyと等しい要素を探す
+     *
+     * @tparam Compare 比較関数の型
+     * @param key 探索キー
+     * @param compare 比較関数 (lowerBoundと同じもの)
+     * @return const Element* 見つかった要素へのポインタ (なければnullptr)
+     */
+    template <typename Compare>
+    const Element* find(const Element& key, Compare compare) const {
+        const auto* found = lowerBound(key, compare);
+        if (found == nullptr || compare(key, *found)) {
+            return nullptr;
+        }
+        return found;
+    }
+
+    /**
+     * @brief `operator<` の順序で、keyと等しい要素を探す
+     *
+     * @param key 探索キー
+     * @return const Element* 見つかった要素へのポインタ (なければnullptr)
+     */
+    const Element* find(const Element& key) const {
+        return find(key, [](const Element& lhs, const Element& rhs) { return lhs < rhs; });
+    }
+
+    /**
+     * @brief 格納できる要素の数を返す
+     *
+     * @return Size
+     */
+    Size capacity() const {
+        return internalDataSize;
+    }
+
+    /**
+     * @brief 格納されている要素の数を返す
+     *
+     * @return Size
+     */
+    Size amount() const {
+        return count;
+    }
+
+    /**
+     * @brief 空かどうか
+     *
+     * @return bool
+     */
+    bool isEmpty() const {
+        return count == 0;
+    }
+};
+
+/**
+ * @brief ツリー
+ *
+ * @tparam Element 要素の型
+ * @tparam Size 要素数の型
+ * @tparam ParentLinked ノードに親へのリンクを持たせるか
+ * @tparam Augmentation ノードに持たせる付加情報 (付加情報を持たせる場合は親へのリンクも必要です)
+ * @tparam Policy ノードプールの並行性ポリシー (既定では専用のプールを持ちます。他のリストやツリーとプールを共有する場合は `SharedPool` を、
+ *                複数のスレッドで共有するプールを使う場合は `concurrent_pool.hpp` の `LockFree` を指定します)
+ *
+ * @note 付加情報は、ツリーの操作 (`appendChild`, `linkNode`, `removeChild`, 回転など) のたびに、変更したノードから根まで計算し直されます。
+ */
+template <typename Element, typename Size = size_t, bool ParentLinked = false, typename Augmentation = NoAugmentation, typename Policy = SingleContext>
+class Tree {
+    static_assert(ParentLinked || !TreeNode<Element, Size, ParentLinked, Augmentation>::augmented, "collection2::Tree: augmented nodes require parent links");
+
+   private:
+    using NodePool = internal::NodePoolHolder<TreeNode<Element, Size, ParentLinked, Augmentation>, Size, Policy>;
+
+    /**
+     * @brief ノードの確保・返却に使うプール (共有プールを使う場合は、そのポインタのみを持つ)
+     */
+    NodePool nodePool;
+
+    /**
+     * @brief 親ノードの子リンクのうち、oldChildを指しているものをnewChildに付け替える
+     *
+     * @param parent 親ノード (nullptrなら何もしない)
+     * @param oldChild 付け替え前の子
+     * @param newChild 付け替え後の子 (nullptrも可)
+     * @note newChildの親リンクもparentに設定します。
+     */
+    static void replaceLink(TreeNode<Element, Size, ParentLinked, Augmentation>* const parent, const TreeNode<Element, Size, ParentLinked, Augmentation>* const oldChild, TreeNode<Element, Size, ParentLinked, Augmentation>* const newChild);
+
+    /**
+     * @brief 部分木の全てのノードをプールへ返却する
+     *
+     * @param node 部分木の根 (nullptrなら何もしない)
+     */
+    void releaseSubtree(TreeNode<Element, Size, ParentLinked, Augmentation>* const node);
+
+    /**
+     * @brief 整列済みの範囲から平衡な部分木を構築する
+     *
+     * @param data 整列済みの要素
+     * @param length 要素数
+     * @param subtreePtr 部分木の根の格納先 (要素数が0ならnullptr)
+     * @return bool 構築できたか
+     * @note ノードは中間順に確保されます。途中でノードが足りなくなった場合は、確保したノードを全て返却してfalseを返します。
+     */
+    bool buildRange(const Element* const data, const Size& length, TreeNode<Element, Size, ParentLinked, Augmentation>** subtreePtr);
+
    public:
     /**
      * @brief 内部データを扱う領域とそのサイズを指定してリストを初期化
      *
      * @param data 内部データ保管用領域
      * @param dataSize 領域サイズ
+     * @note 既定のポリシー (`SingleContext`) でのみ使用できます。
+     */
+    constexpr Tree(TreeNode<Element, Size, ParentLinked, Augmentation>* const data, const Size& dataSize);
+
+    /**
+     * @brief 構築済みのノードを先頭に持つ領域を指定してツリーを初期化
+     *
+     * @param data 内部データ保管用領域
+     * @param dataSize 領域サイズ
+     * @param prebuiltSize 構築済みのノードの数 (領域の先頭から数える)
+     * @note `TreeNode` のコンストラクタで静的に初期化したノード配列を渡すと、起動時にツリーを組み立てる必要がなくなります。
+     *       構築済みのノードも、以降は `retainNode` で確保したノードと同様に扱えます。
+     * @note ノード配列はツリーから書き換えられるため、`const` にはできません (読み取り専用の領域には配置されません)。
+     * @note 既定のポリシー (`SingleContext`) でのみ使用できます。
      */
-    Tree(TreeNode<Element, Size>* const data, const Size& dataSize);
+    constexpr Tree(TreeNode<Element, Size, ParentLinked, Augmentation>* const data, const Size& dataSize, const Size& prebuiltSize);
+
+    /**
+     * @brief 他のリストやツリーと共有するノードプールを指定してツリーを初期化
+     *
+     * @param pool ノードプール
+     * @note プールはツリーより長く存続する必要があります。ツリーは自身の根を管理しないため、
+     *       破棄する前に `removeChild` などで不要なノードをプールへ返却してください。
+     * @note `SharedPool` または `LockFree` ポリシーでのみ使用できます。
+     */
+    explicit constexpr Tree(typename NodePool::PoolType& pool);
 
     Tree(const Tree&) = delete;
     Tree& operator=(const Tree&) = delete;
@@ -88,25 +509,25 @@ class Tree {
 
     /**
      * @brief ツリーノードプールを初期化する
-     * @note 既存のツリーは全て削除されます。
+     * @note 既存のツリーは全て削除されます。共有プールを使用している場合は、同じプールを使う他のリストやツリーのノードも全て失われます。
      */
     void initializeTreeNodePool();
 
     /**
      * @brief 内部ノードプールから空きノードを探し、確保する
      *
-     * @return TreeNode<Element, Size>* 確保できたノードのポインタ
+     * @return TreeNode<Element, Size, ParentLinked, Augmentation>* 確保できたノードのポインタ
      * @note 空きノードがない場合はnullptrが返ります。
      */
-    TreeNode<Element, Size>* retainNode() const;
+    TreeNode<Element, Size, ParentLinked, Augmentation>* retainNode();
 
     /**
      * @brief 内部ノードプールから空きノードを探し、値を割り当てる
      *
-     * @return TreeNode<Element, Size>* 確保できたノードのポインタ
+     * @return TreeNode<Element, Size, ParentLinked, Augmentation>* 確保できたノードのポインタ
      * @note 空きノードがない場合はnullptrが返ります。
      */
-    TreeNode<Element, Size>* retainNode(const Element& element) const;
+    TreeNode<Element, Size, ParentLinked, Augmentation>* retainNode(const Element& element);
 
     /**
      * @brief 子ノードを生成し、既存ノードに追加する
@@ -120,10 +541,10 @@ class Tree {
      * @note すでに子ノードを持っているか内部データ管理領域がいっぱいの場合、この関数は何もせずに戻ります。
      */
     OperationResult appendChild(
-        TreeNode<Element, Size>* parent,
+        TreeNode<Element, Size, ParentLinked, Augmentation>* parent,
         const Element& target,
         const TreeNodeSide side,
-        TreeNode<Element, Size>** addedNodePtr = nullptr);
+        TreeNode<Element, Size, ParentLinked, Augmentation>** addedNodePtr = nullptr);
 
     /**
      * @brief ノードを別のノードに接続する
@@ -133,8 +554,8 @@ class Tree {
      * @param side 接続する位置
      */
     OperationResult linkNode(
-        TreeNode<Element, Size>& parent,
-        TreeNode<Element, Size>* node,
+        TreeNode<Element, Size, ParentLinked, Augmentation>& parent,
+        TreeNode<Element, Size, ParentLinked, Augmentation>* node,
         const TreeNodeSide side) const;
 
     /**
@@ -142,51 +563,209 @@ class Tree {
      *
      * @param target 削除対象のノード
      *
-     * @note ノードがリーフでない場合、子は再帰的に削除されます。
+     * @note ノードがリーフでない場合、子孫が全て削除され、ノード自身は残ります。
+     */
+    void removeChild(TreeNode<Element, Size, ParentLinked, Augmentation>* target);
+
+    /**
+     * @brief 整列済みの要素の配列から、完全に平衡な二分探索木を構築する
+     *
+     * @param data 整列済みの要素
+     * @param length 要素数
+     * @param rootPtr 構築したツリーの根の格納先
+     * @return OperationResult 操作結果
+     *
+     * @note 各要素を一度ずつ辿るだけで構築するため、O(n)で完了します。左右の部分木の高さの差は高々1になります。
+     * @note ノードは中間順に確保されます。未使用のプールから確保する場合、ノードは要素と同じ順序で領域に隙間なく並びます。
+     * @note 空きノードが足りない場合は何もせずにOverflowを返します。付加情報を持つツリーでは、構築と同時に計算されます。
+     */
+    OperationResult buildBalanced(const Element* const data, const Size& length, TreeNode<Element, Size, ParentLinked, Augmentation>** rootPtr);
+
+    /**
+     * @brief ノードを中心に左回転する
+     *
+     * @param node 回転の中心となるノード
+     * @return TreeNode<Element, Size, ParentLinked, Augmentation>* 新しい部分木の根 (元の右の子)。右の子がない場合は何もせずにnullptrを返します
+     *
+     * @note 親へのリンクを持つ場合は、元の親の子リンクも付け替えます。
+     *       持たない場合は、返り値を元の親の子リンクへ呼び出し側で繋ぎ直してください。
+     */
+    TreeNode<Element, Size, ParentLinked, Augmentation>* rotateLeft(TreeNode<Element, Size, ParentLinked, Augmentation>* node);
+
+    /**
+     * @brief ノードを中心に右回転する
+     *
+     * @param node 回転の中心となるノード
+     * @return TreeNode<Element, Size, ParentLinked, Augmentation>* 新しい部分木の根 (元の左の子)。左の子がない場合は何もせずにnullptrを返します
+     *
+     * @note 親へのリンクを持つ場合は、元の親の子リンクも付け替えます。
+     *       持たない場合は、返り値を元の親の子リンクへ呼び出し側で繋ぎ直してください。
+     */
+    TreeNode<Element, Size, ParentLinked, Augmentation>* rotateRight(TreeNode<Element, Size, ParentLinked, Augmentation>* node);
+
+    /**
+     * @brief 部分木を別の部分木で置き換える
+     *
+     * @param target 置き換えられる部分木の根
+     * @param replacement 新たに繋ぐ部分木の根 (nullptrならtargetを切り離すだけ)
+     * @return OperationResult 操作結果
+     *
+     * @note 親へのリンクを持つツリーでのみ使用できます。
+     * @note 切り離されたtargetの部分木は解放されません。不要であれば `removeChild` などで返却してください。
+     *       replacementが他のノードに繋がっている場合は、先にそこから切り離されます。
+     */
+    OperationResult replaceSubtree(TreeNode<Element, Size, ParentLinked, Augmentation>* target, TreeNode<Element, Size, ParentLinked, Augmentation>* replacement);
+
+    /**
+     * @brief 部分木を親から切り離す
+     *
+     * @param node 切り離す部分木の根
+     * @return OperationResult 操作結果
+     *
+     * @note 親へのリンクを持つツリーでのみ使用できます。切り離した部分木は解放されず、nodeを根とする独立した木になります。
+     */
+    OperationResult detach(TreeNode<Element, Size, ParentLinked, Augmentation>* node);
+
+    /**
+     * @brief 二分探索木として構成された部分木を、探索用の暗黙的配列に書き出す
+     *
+     * @param root 書き出す部分木の根
+     * @param destination 書き出し先
+     * @return OperationResult 操作結果
+     *
+     * @note 左の子 < 親 < 右の子 の順序を持つツリーを想定しています。書き出した結果は元のツリーの形によらず完全二分木になります。
+     * @note 書き出し先の容量が足りない場合は何もせずにOverflowを返します。
+     */
+    OperationResult freeze(const TreeNode<Element, Size, ParentLinked, Augmentation>* root, FrozenTree<Element, Size>& destination) const;
+
+    /**
+     * @brief ノードから根までの付加情報を計算し直す
+     *
+     * @param node 起点のノード
+     * @note ノードの要素を直接書き換えた場合に呼び出してください。付加情報を持たないツリーでは何もしません。
+     */
+    void updateAugmentation(TreeNode<Element, Size, ParentLinked, Augmentation>* const node) const {
+        TreeNode<Element, Size, ParentLinked, Augmentation>::refreshPath(node);
+    }
+
+    /**
+     * @brief 部分木の全てのノードの付加情報を計算し直す
+     *
+     * @param root 部分木の根
+     * @note 構築済みのノード配列を渡した場合など、付加情報が未計算のノードに対して使用します (O(n))。
+     */
+    void rebuildAugmentation(TreeNode<Element, Size, ParentLinked, Augmentation>* const root) const;
+
+    /**
+     * @brief 部分木のノード数を返す
+     *
+     * @param node 部分木の根
+     * @return Size ノード数 (nullptrなら0)
+     * @note 付加情報 (`SubtreeSize` または `SubtreeAggregate`) を持つツリーでのみ使用できます。
+     */
+    static Size subtreeSizeOf(const TreeNode<Element, Size, ParentLinked, Augmentation>* const node) {
+        static_assert(TreeNode<Element, Size, ParentLinked, Augmentation>::augmented, "collection2::Tree::subtreeSizeOf requires subtree sizes");
+        return TreeNode<Element, Size, ParentLinked, Augmentation>::sizeOf(node);
+    }
+
+    /**
+     * @brief 部分木の中間順で、index番目 (0始まり) のノードを返す
+     *
+     * @param root 部分木の根
+     * @param index 順位
+     * @return TreeNode<Element, Size, ParentLinked, Augmentation>* 見つかったノード (範囲外ならnullptr)
+     * @note 付加情報を持つツリーでのみ使用できます。O(高さ)で完了します。
+     */
+    TreeNode<Element, Size, ParentLinked, Augmentation>* select(TreeNode<Element, Size, ParentLinked, Augmentation>* root, Size index) const;
+
+    /**
+     * @brief ノードが木全体の中間順で何番目 (0始まり) にあるかを返す
+     *
+     * @param node 対象のノード
+     * @return Size 順位
+     * @note 付加情報を持つツリーでのみ使用できます。親へのリンクを根まで辿るため、O(高さ)で完了します。
+     */
+    Size rank(const TreeNode<Element, Size, ParentLinked, Augmentation>* node) const;
+
+    /**
+     * @brief 二分探索木として構成された部分木のうち、keyより小さい要素の数を返す
+     *
+     * @tparam Compare 比較関数の型
+     * @param root 部分木の根
+     * @param key 探索キー
+     * @param compare 比較関数 `bool(const Element& lhs, const Element& rhs)`。ツリーの左右の順序と一致している必要があります
+     * @return Size keyより小さい要素の数
+     * @note 付加情報を持つツリーでのみ使用できます。O(高さ)で完了します。
      */
-    void removeChild(TreeNode<Element, Size>* target);
+    template <typename Compare>
+    Size countLess(const TreeNode<Element, Size, ParentLinked, Augmentation>* root, const Element& key, Compare compare) const;
+
+    /**
+     * @brief `operator<` の順序で、keyより小さい要素の数を返す
+     *
+     * @param root 部分木の根
+     * @param key 探索キー
+     * @return Size keyより小さい要素の数
+     */
+    Size countLess(const TreeNode<Element, Size, ParentLinked, Augmentation>* root, const Element& key) const {
+        return countLess(root, key, [](const Element& lhs, const Element& rhs) { return lhs < rhs; });
+    }
 
     /**
      * @brief ツリーが持てるノードおよびリーフの全体長を返す
      *
      * @return Size
+     * @note 共有プールを使用している場合は、プール全体の大きさを返します。
      */
-    Size capacity() const {
-        return internalDataSize;
+    constexpr Size capacity() const {
+        return nodePool->capacity();
     }
-};
 
-template <typename Element, typename Size>
-Tree<Element, Size>::Tree(TreeNode<Element, Size>* const data, const Size& dataSize)
-    : internalData(data), internalDataSize(dataSize) {
-    initializeTreeNodePool();
+    /**
+     * @brief 確保されているノードの数を返す
+     *
+     * @return Size
+     * @note 共有プールを使用している場合は、プール全体で確保されているノードの数を返します。
+     */
+    constexpr Size amount() const {
+        return nodePool->amount();
+    }
 };
 
-template <typename Element, typename Size>
-inline void Tree<Element, Size>::initializeTreeNodePool() {
-    for (Size i = 0; i < internalDataSize; i++) {
-        internalData[i].isEnabled = false;
-    }
+template <typename Element, typename Size, bool ParentLinked, typename Augmentation, typename Policy>
+constexpr Tree<Element, Size, ParentLinked, Augmentation, Policy>::Tree(TreeNode<Element, Size, ParentLinked, Augmentation>* const data, const Size& dataSize)
+    : nodePool(data, dataSize) {
+    static_assert(NodePool::owning, "collection2::Tree: storage constructor requires the SingleContext policy; pass a pool instead");
 }
 
-template <typename Element, typename Size>
-inline TreeNode<Element, Size>* Tree<Element, Size>::retainNode() const {
-    for (Size i = 0; i < internalDataSize; i++) {
-        if (internalData[i].isEnabled) {
-            continue;
-        }
+template <typename Element, typename Size, bool ParentLinked, typename Augmentation, typename Policy>
+constexpr Tree<Element, Size, ParentLinked, Augmentation, Policy>::Tree(TreeNode<Element, Size, ParentLinked, Augmentation>* const data, const Size& dataSize, const Size& prebuiltSize)
+    : nodePool(data, dataSize, prebuiltSize) {
+    static_assert(NodePool::owning, "collection2::Tree: storage constructor requires the SingleContext policy; pass a pool instead");
+}
 
-        // 見つかったらノードを初期化して返す
-        internalData[i].isEnabled = true;
-        internalData[i].lhs = nullptr;
-        internalData[i].rhs = nullptr;
-        return &(internalData[i]);
+template <typename Element, typename Size, bool ParentLinked, typename Augmentation, typename Policy>
+constexpr Tree<Element, Size, ParentLinked, Augmentation, Policy>::Tree(typename NodePool::PoolType& pool)
+    : nodePool(pool) {
+    static_assert(!NodePool::owning, "collection2::Tree: a shared pool requires the SharedPool or LockFree policy");
+}
+
+template <typename Element, typename Size, bool ParentLinked, typename Augmentation, typename Policy>
+inline void Tree<Element, Size, ParentLinked, Augmentation, Policy>::initializeTreeNodePool() {
+    nodePool->reset();
+}
+
+template <typename Element, typename Size, bool ParentLinked, typename Augmentation, typename Policy>
+inline TreeNode<Element, Size, ParentLinked, Augmentation>* Tree<Element, Size, ParentLinked, Augmentation, Policy>::retainNode() {
+    auto* node = nodePool->acquire();
+    if (node != nullptr) {
+        TreeNode<Element, Size, ParentLinked, Augmentation>::refresh(node);
     }
-    return nullptr;
+    return node;
 }
 
-template <typename Element, typename Size>
-inline TreeNode<Element, Size>* collection2::Tree<Element, Size>::retainNode(const Element& element) const {
+template <typename Element, typename Size, bool ParentLinked, typename Augmentation, typename Policy>
+inline TreeNode<Element, Size, ParentLinked, Augmentation>* collection2::Tree<Element, Size, ParentLinked, Augmentation, Policy>::retainNode(const Element& element) {
     // ノードを確保
     auto* node = retainNode();
     if (node == nullptr) {
@@ -195,15 +774,16 @@ inline TreeNode<Element, Size>* collection2::Tree<Element, Size>::retainNode(con
 
     // 値を設定して返す
     node->element = element;
+    TreeNode<Element, Size, ParentLinked, Augmentation>::refresh(node);
     return node;
 }
 
-template <typename Element, typename Size>
-inline OperationResult collection2::Tree<Element, Size>::appendChild(
-    TreeNode<Element, Size>* parent,
+template <typename Element, typename Size, bool ParentLinked, typename Augmentation, typename Policy>
+inline OperationResult collection2::Tree<Element, Size, ParentLinked, Augmentation, Policy>::appendChild(
+    TreeNode<Element, Size, ParentLinked, Augmentation>* parent,
     const Element& target,
     const TreeNodeSide side,
-    TreeNode<Element, Size>** addedNodePtr) {
+    TreeNode<Element, Size, ParentLinked, Augmentation>** addedNodePtr) {
     // 親ノードがnullであってはならない(単純なノードの確保はretainNodeを使う)
     if (parent == nullptr) {
         return OperationResult::Empty;
@@ -220,6 +800,7 @@ inline OperationResult collection2::Tree<Element, Size>::appendChild(
 
     // 値をセット
     newNode->element = target;
+    TreeNode<Element, Size, ParentLinked, Augmentation>::refresh(newNode);
 
     // 新規生成したノードへのポインタを渡す
     if (addedNodePtr != nullptr) {
@@ -230,8 +811,8 @@ inline OperationResult collection2::Tree<Element, Size>::appendChild(
     return linkNode(*parent, newNode, side);
 }
 
-template <typename Element, typename Size>
-inline OperationResult collection2::Tree<Element, Size>::linkNode(TreeNode<Element, Size>& parent, TreeNode<Element, Size>* node, const TreeNodeSide side) const {
+template <typename Element, typename Size, bool ParentLinked, typename Augmentation, typename Policy>
+inline OperationResult collection2::Tree<Element, Size, ParentLinked, Augmentation, Policy>::linkNode(TreeNode<Element, Size, ParentLinked, Augmentation>& parent, TreeNode<Element, Size, ParentLinked, Augmentation>* node, const TreeNodeSide side) const {
     if (node == nullptr) {
         return OperationResult::Empty;
     }
@@ -249,26 +830,335 @@ inline OperationResult collection2::Tree<Element, Size>::linkNode(TreeNode<Eleme
         }
         parent.rhs = node;
     }
+    node->linkParent(&parent);
+    TreeNode<Element, Size, ParentLinked, Augmentation>::refreshPath(&parent);
     return OperationResult::Success;
 }
 
-template <typename Element, typename Size>
-inline void collection2::Tree<Element, Size>::removeChild(TreeNode<Element, Size>* target) {
-    // リーフならデアクティベートして終わり
+template <typename Element, typename Size, bool ParentLinked, typename Augmentation, typename Policy>
+inline void collection2::Tree<Element, Size, ParentLinked, Augmentation, Policy>::removeChild(TreeNode<Element, Size, ParentLinked, Augmentation>* target) {
+    // リーフなら親から外し、プールに返却して終わり
     if (target->isLeaf()) {
-        target->isEnabled = false;
+        auto* parent = target->parentNode();
+        replaceLink(parent, target, nullptr);
+        nodePool->release(target);
+        TreeNode<Element, Size, ParentLinked, Augmentation>::refreshPath(parent);
         return;
     }
 
-    // そうでなければ再帰的に削除
-    if (target->lhs != nullptr) {
-        removeChild(target->lhs);
-        target->lhs = nullptr;
+    // そうでなければ子孫を全て返却する
+    releaseSubtree(target->lhs);
+    target->lhs = nullptr;
+    releaseSubtree(target->rhs);
+    target->rhs = nullptr;
+    TreeNode<Element, Size, ParentLinked, Augmentation>::refreshPath(target);
+}
+
+template <typename Element, typename Size, bool ParentLinked, typename Augmentation, typename Policy>
+inline void collection2::Tree<Element, Size, ParentLinked, Augmentation, Policy>::releaseSubtree(TreeNode<Element, Size, ParentLinked, Augmentation>* const node) {
+    if (node == nullptr) {
+        return;
+    }
+    releaseSubtree(node->lhs);
+    releaseSubtree(node->rhs);
+    nodePool->release(node);
+}
+
+template <typename Element, typename Size, bool ParentLinked, typename Augmentation, typename Policy>
+inline OperationResult collection2::Tree<Element, Size, ParentLinked, Augmentation, Policy>::buildBalanced(const Element* const data, const Size& length, TreeNode<Element, Size, ParentLinked, Augmentation>** rootPtr) {
+    if (length == 0) {
+        return OperationResult::Empty;
     }
-    if (target->rhs != nullptr) {
-        removeChild(target->rhs);
-        target->rhs = nullptr;
+
+    // 全ての要素を置ける空きがなければ戻る
+    if (nodePool->capacity() - nodePool->amount() < length) {
+        return OperationResult::Overflow;
+    }
+
+    // 共有プールを他のスレッドと使っている場合は、確認した後に空きが減ることもある
+    TreeNode<Element, Size, ParentLinked, Augmentation>* root = nullptr;
+    if (!buildRange(data, length, &root)) {
+        return OperationResult::Overflow;
+    }
+    if (rootPtr != nullptr) {
+        *rootPtr = root;
+    }
+    return OperationResult::Success;
+}
+
+template <typename Element, typename Size, bool ParentLinked, typename Augmentation, typename Policy>
+inline bool collection2::Tree<Element, Size, ParentLinked, Augmentation, Policy>::buildRange(const Element* const data, const Size& length, TreeNode<Element, Size, ParentLinked, Augmentation>** subtreePtr) {
+    *subtreePtr = nullptr;
+    if (length == 0) {
+        return true;
+    }
+
+    // 左の部分木から順に構築し、中央の要素を根とする
+    const Size leftLength = length / 2;
+    TreeNode<Element, Size, ParentLinked, Augmentation>* lhs = nullptr;
+    if (!buildRange(data, leftLength, &lhs)) {
+        return false;
+    }
+    auto* node = nodePool->acquire();
+    if (node == nullptr) {
+        releaseSubtree(lhs);
+        return false;
+    }
+    node->element = data[leftLength];
+    TreeNode<Element, Size, ParentLinked, Augmentation>* rhs = nullptr;
+    if (!buildRange(data + leftLength + 1, static_cast<Size>(length - leftLength - 1), &rhs)) {
+        releaseSubtree(lhs);
+        nodePool->release(node);
+        return false;
+    }
+
+    // 子の付加情報は計算済みなので、このノードだけ計算すればよい
+    node->lhs = lhs;
+    node->rhs = rhs;
+    if (lhs != nullptr) {
+        lhs->linkParent(node);
+    }
+    if (rhs != nullptr) {
+        rhs->linkParent(node);
+    }
+    TreeNode<Element, Size, ParentLinked, Augmentation>::refresh(node);
+    *subtreePtr = node;
+    return true;
+}
+
+template <typename Element, typename Size, bool ParentLinked, typename Augmentation, typename Policy>
+inline void collection2::Tree<Element, Size, ParentLinked, Augmentation, Policy>::replaceLink(TreeNode<Element, Size, ParentLinked, Augmentation>* const parent, const TreeNode<Element, Size, ParentLinked, Augmentation>* const oldChild, TreeNode<Element, Size, ParentLinked, Augmentation>* const newChild) {
+    if (newChild != nullptr) {
+        newChild->linkParent(parent);
+    }
+    if (parent == nullptr) {
+        return;
+    }
+    if (parent->lhs == oldChild) {
+        parent->lhs = newChild;
+    } else if (parent->rhs == oldChild) {
+        parent->rhs = newChild;
+    }
+}
+
+template <typename Element, typename Size, bool ParentLinked, typename Augmentation, typename Policy>
+inline TreeNode<Element, Size, ParentLinked, Augmentation>* collection2::Tree<Element, Size, ParentLinked, Augmentation, Policy>::rotateLeft(TreeNode<Element, Size, ParentLinked, Augmentation>* node) {
+    if (node == nullptr || node->rhs == nullptr) {
+        return nullptr;
+    }
+
+    // 右の子pivotを持ち上げ、pivotの左部分木をnodeの右に付け替える
+    auto* pivot = node->rhs;
+    auto* parent = node->parentNode();
+    node->rhs = pivot->lhs;
+    if (node->rhs != nullptr) {
+        node->rhs->linkParent(node);
+    }
+    pivot->lhs = node;
+    replaceLink(parent, node, pivot);
+    node->linkParent(pivot);
+
+    // 部分木全体の付加情報は変わらないので、入れ替えた二つだけ計算し直す
+    TreeNode<Element, Size, ParentLinked, Augmentation>::refresh(node);
+    TreeNode<Element, Size, ParentLinked, Augmentation>::refresh(pivot);
+    return pivot;
+}
+
+template <typename Element, typename Size, bool ParentLinked, typename Augmentation, typename Policy>
+inline TreeNode<Element, Size, ParentLinked, Augmentation>* collection2::Tree<Element, Size, ParentLinked, Augmentation, Policy>::rotateRight(TreeNode<Element, Size, ParentLinked, Augmentation>* node) {
+    if (node == nullptr || node->lhs == nullptr) {
+        return nullptr;
+    }
+
+    // 左の子pivotを持ち上げ、pivotの右部分木をnodeの左に付け替える
+    auto* pivot = node->lhs;
+    auto* parent = node->parentNode();
+    node->lhs = pivot->rhs;
+    if (node->lhs != nullptr) {
+        node->lhs->linkParent(node);
+    }
+    pivot->rhs = node;
+    replaceLink(parent, node, pivot);
+    node->linkParent(pivot);
+
+    // 部分木全体の付加情報は変わらないので、入れ替えた二つだけ計算し直す
+    TreeNode<Element, Size, ParentLinked, Augmentation>::refresh(node);
+    TreeNode<Element, Size, ParentLinked, Augmentation>::refresh(pivot);
+    return pivot;
+}
+
+template <typename Element, typename Size, bool ParentLinked, typename Augmentation, typename Policy>
+inline OperationResult collection2::Tree<Element, Size, ParentLinked, Augmentation, Policy>::replaceSubtree(TreeNode<Element, Size, ParentLinked, Augmentation>* target, TreeNode<Element, Size, ParentLinked, Augmentation>* replacement) {
+    static_assert(ParentLinked, "collection2::Tree::replaceSubtree requires parent links");
+    if (target == nullptr) {
+        return OperationResult::Empty;
+    }
+    if (target == replacement) {
+        return OperationResult::Success;
+    }
+
+    // 置き換える側を元の場所から外してから、targetの位置に繋ぐ
+    if (replacement != nullptr) {
+        auto* replacementParent = replacement->parentNode();
+        replaceLink(replacementParent, replacement, nullptr);
+        TreeNode<Element, Size, ParentLinked, Augmentation>::refreshPath(replacementParent);
+    }
+    auto* parent = target->parentNode();
+    replaceLink(parent, target, replacement);
+    target->linkParent(nullptr);
+    TreeNode<Element, Size, ParentLinked, Augmentation>::refreshPath(parent);
+    return OperationResult::Success;
+}
+
+template <typename Element, typename Size, bool ParentLinked, typename Augmentation, typename Policy>
+inline OperationResult collection2::Tree<Element, Size, ParentLinked, Augmentation, Policy>::detach(TreeNode<Element, Size, ParentLinked, Augmentation>* node) {
+    return replaceSubtree(node, nullptr);
+}
+
+template <typename Element, typename Size, bool ParentLinked, typename Augmentation, typename Policy>
+inline OperationResult collection2::Tree<Element, Size, ParentLinked, Augmentation, Policy>::freeze(const TreeNode<Element, Size, ParentLinked, Augmentation>* root, FrozenTree<Element, Size>& destination) const {
+    if (root == nullptr) {
+        destination.count = 0;
+        return OperationResult::Empty;
+    }
+
+    // 書き出し先に収まるか
+    const Size nodeCount = FrozenTree<Element, Size>::countNodes(root);
+    if (nodeCount > destination.internalDataSize) {
+        return OperationResult::Overflow;
+    }
+    destination.count = nodeCount;
+
+    // 中間順の先頭 = 最も左の位置から書き出す
+    size_t position = 1;
+    while (position * 2 <= nodeCount) {
+        position *= 2;
+    }
+    destination.layout(root, position);
+
+    return OperationResult::Success;
+}
+
+template <typename Element, typename Size, bool ParentLinked, typename Augmentation, typename Policy>
+inline void collection2::Tree<Element, Size, ParentLinked, Augmentation, Policy>::rebuildAugmentation(TreeNode<Element, Size, ParentLinked, Augmentation>* const root) const {
+    if (root == nullptr) {
+        return;
+    }
+    rebuildAugmentation(root->lhs);
+    rebuildAugmentation(root->rhs);
+    TreeNode<Element, Size, ParentLinked, Augmentation>::refresh(root);
+}
+
+template <typename Element, typename Size, bool ParentLinked, typename Augmentation, typename Policy>
+inline TreeNode<Element, Size, ParentLinked, Augmentation>* collection2::Tree<Element, Size, ParentLinked, Augmentation, Policy>::select(TreeNode<Element, Size, ParentLinked, Augmentation>* root, Size index) const {
+    // 左の部分木の大きさと比べて、左右どちらに進むかを決める
+    auto* node = root;
+    while (node != nullptr) {
+        const Size leftSize = subtreeSizeOf(node->lhs);
+        if (index < leftSize) {
+            node = node->lhs;
+        } else if (index == leftSize) {
+            return node;
+        } else {
+            index -= leftSize + 1;
+            node = node->rhs;
+        }
+    }
+    return nullptr;
+}
+
+template <typename Element, typename Size, bool ParentLinked, typename Augmentation, typename Policy>
+inline Size collection2::Tree<Element, Size, ParentLinked, Augmentation, Policy>::rank(const TreeNode<Element, Size, ParentLinked, Augmentation>* node) const {
+    // 自身の左の部分木に加え、右の子として辿った祖先とその左の部分木を数える
+    Size position = subtreeSizeOf(node->lhs);
+    const auto* parent = node->parentNode();
+    while (parent != nullptr) {
+        if (parent->rhs == node) {
+            position += subtreeSizeOf(parent->lhs) + 1;
+        }
+        node = parent;
+        parent = parent->parentNode();
+    }
+    return position;
+}
+
+template <typename Element, typename Size, bool ParentLinked, typename Augmentation, typename Policy>
+template <typename Compare>
+inline Size collection2::Tree<Element, Size, ParentLinked, Augmentation, Policy>::countLess(const TreeNode<Element, Size, ParentLinked, Augmentation>* root, const Element& key, Compare compare) const {
+    Size count = 0;
+    const auto* node = root;
+    while (node != nullptr) {
+        if (compare(node->element, key)) {
+            count += subtreeSizeOf(node->lhs) + 1;
+            node = node->rhs;
+        } else {
+            node = node->lhs;
+        }
+    }
+    return count;
+}
+
+template <typename Element, typename Size>
+template <typename Node>
+inline Size FrozenTree<Element, Size>::countNodes(const Node* node) {
+    if (node == nullptr) {
+        return 0;
+    }
+    return 1 + countNodes(node->lhs) + countNodes(node->rhs);
+}
+
+template <typename Element, typename Size>
+template <typename Node>
+inline void FrozenTree<Element, Size>::layout(const Node* node, size_t& position) {
+    if (node == nullptr) {
+        return;
+    }
+
+    layout(node->lhs, position);
+    internalData[position - 1] = node->element;
+    position = nextInOrder(position);
+    layout(node->rhs, position);
+}
+
+template <typename Element, typename Size>
+inline size_t FrozenTree<Element, Size>::nextInOrder(size_t position) const {
+    // 右の子があれば、その部分木の最も左
+    if (position * 2 + 1 <= count) {
+        position = position * 2 + 1;
+        while (position * 2 <= count) {
+            position *= 2;
+        }
+        return position;
+    }
+
+    // なければ、自身が左の子になっている最初の祖先
+    while ((position & 1) != 0) {
+        position >>= 1;
+    }
+    return position >> 1;
+}
+
+template <typename Element, typename Size>
+template <typename Compare>
+inline size_t FrozenTree<Element, Size>::search(const Element& key, Compare compare) const {
+    // 比較結果で左右の子を選ぶ 分岐せずに添字を計算する
+    size_t position = 1;
+    while (position <= count) {
+#if defined(__GNUC__)
+        // 4段先の子孫は連続した位置に並んでいるので、まとめて先読みしておく
+        const size_t prefetchPosition = position * 16;
+        if (prefetchPosition <= count) {
+            __builtin_prefetch(internalData + prefetchPosition - 1);
+        }
+#endif
+        position = position * 2 + static_cast<size_t>(compare(internalData[position - 1], key));
+    }
+
+    // 最後に左へ進んだ位置まで戻る (右へ進んだ分の下位ビットを捨てる)
+    while ((position & 1) != 0) {
+        position >>= 1;
     }
+    return position >> 1;
 }
 
 }  // namespace collection2
@@ -0,0 +1,234 @@
+//
+// トリプルバッファ
+//
+
+#ifndef COLLECTION2_TRIPLE_BUFFER_H
+#define COLLECTION2_TRIPLE_BUFFER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if !defined(__AVR__)
+#include <atomic>
+#endif
+
+#include "common.hpp"
+
+namespace collection2 {
+
+namespace internal {
+
+/**
+ * @brief トリプルバッファの共有状態を交換する (排他制御を行わない)
+ *
+ * @tparam Policy 並行性ポリシー
+ * @note 割り込みハンドラと共有する場合の特殊化は `interrupt.hpp` にあります。
+ */
+template <typename Policy>
+struct TripleBufferSync {
+    /**
+     * @brief 共有状態の型
+     */
+    using State = volatile uint8_t;
+
+    /**
+     * @brief 追加側から共有状態を交換する
+     */
+    static uint8_t exchangeFromProducer(volatile uint8_t& state, const uint8_t value) {
+        const uint8_t previous = state;
+        state = value;
+        return previous;
+    }
+
+    /**
+     * @brief 取り出し側から共有状態を交換する
+     */
+    static uint8_t exchangeFromConsumer(volatile uint8_t& state, const uint8_t value) {
+        const uint8_t previous = state;
+        state = value;
+        return previous;
+    }
+
+    /**
+     * @brief 取り出し側から共有状態を読む
+     */
+    static uint8_t loadFromConsumer(const volatile uint8_t& state) {
+        return state;
+    }
+};
+
+#if !defined(__AVR__)
+/**
+ * @brief トリプルバッファの共有状態を交換する (スレッド間、ホスト環境のみ)
+ * @note 交換はアトミックに行い、追加側の書き込みが取り出し側から見えることを保証します。
+ */
+template <>
+struct TripleBufferSync<LockFree> {
+    using State = std::atomic<uint8_t>;
+
+    static uint8_t exchangeFromProducer(State& state, const uint8_t value) {
+        return state.exchange(value, std::memory_order_acq_rel);
+    }
+
+    static uint8_t exchangeFromConsumer(State& state, const uint8_t value) {
+        return state.exchange(value, std::memory_order_acq_rel);
+    }
+
+    static uint8_t loadFromConsumer(const State& state) {
+        return state.load(std::memory_order_acquire);
+    }
+};
+#else
+/**
+ * @brief AVR環境ではスレッド間の同期を提供しない (`LockFree` を指定するとコンパイルエラーとなる)
+ * @note 割り込みハンドラと共有する場合は `interrupt.hpp` のポリシーを指定してください。
+ */
+template <>
+struct TripleBufferSync<LockFree>;
+#endif
+
+}  // namespace internal
+
+/**
+ * @brief 最新の値だけを受け渡すトリプルバッファ
+ *
+ * @tparam Element 要素の型
+ * @tparam Policy 並行性ポリシー (割り込みハンドラと共有する場合は `interrupt.hpp` のポリシーを、スレッド間で共有する場合は `LockFree` を指定します)
+ *
+ * @note 追加側・取り出し側はそれぞれ自分専用の領域を一つずつ持ち、残る一つを受け渡し用とします。
+ *       公開・更新は受け渡し用の領域と自分の領域の番号を1バイトの共有状態の上で交換するだけなので、どちらの側も待たされず、要素のコピーも生じません。
+ * @note 取り出し側が更新するより先に追加側が何度公開しても、取り出し側が受け取るのは最後に公開された値だけです。
+ * @note 追加側・取り出し側はそれぞれ一つのコンテキストに限られます。
+ */
+template <typename Element, typename Policy = SingleContext>
+class TripleBuffer {
+   private:
+    using Sync = internal::TripleBufferSync<Policy>;
+
+    /**
+     * @brief 領域の番号を取り出すマスク
+     */
+    static constexpr uint8_t IndexMask = 0x03;
+
+    /**
+     * @brief 受け渡し用の領域に、取り出し側がまだ受け取っていない値があることを示すフラグ
+     */
+    static constexpr uint8_t FreshFlag = 0x04;
+
+    /**
+     * @brief 内部データ管理領域 (3要素)
+     */
+    Element* const internalData;
+
+    /**
+     * @brief 追加側の領域の番号 (追加側だけが読み書きする)
+     */
+    uint8_t writeIndex = 0;
+
+    /**
+     * @brief 取り出し側の領域の番号 (取り出し側だけが読み書きする)
+     */
+    uint8_t readIndex = 1;
+
+    /**
+     * @brief 受け渡し用の領域の番号とフラグ (両方の側が交換する)
+     */
+    typename Sync::State sharedState{2};
+
+   public:
+    /**
+     * @brief 3要素の領域を指定してトリプルバッファを初期化
+     *
+     * @param data 内部データ保管用領域
+     * @note 取り出し側は、最初の値が公開されるまで `data[1]` を参照します。
+     */
+    explicit constexpr TripleBuffer(Element (&data)[3]) : internalData(data){};
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    ~TripleBuffer() = default;
+
+    /**
+     * @brief 追加側の領域を返す (追加側のコンテキストから呼び出す)
+     *
+     * @return Element* 次に公開する値を書き込む領域
+     * @note 書き込み終えたら `publish` を呼び出します。公開するまで取り出し側からは見えません。
+     */
+    Element* writeSlot() {
+        return internalData + writeIndex;
+    }
+
+    /**
+     * @brief 追加側の領域に書き込んだ値を公開する (追加側のコンテキストから呼び出す)
+     *
+     * @note 取り出し側がまだ受け取っていない値は、新しい値で置き換えられます。
+     */
+    void publish() {
+        internal::compilerBarrier();
+        writeIndex = Sync::exchangeFromProducer(sharedState, static_cast<uint8_t>(writeIndex | FreshFlag)) & IndexMask;
+    }
+
+    /**
+     * @brief 値を書き込んで公開する (追加側のコンテキストから呼び出す)
+     *
+     * @param data 公開する値
+     * @return OperationResult 操作結果 (常にSuccess)
+     */
+    OperationResult write(const Element& data) {
+        *writeSlot() = data;
+        publish();
+        return OperationResult::Success;
+    }
+
+    /**
+     * @brief 新しい値が公開されていれば、それを取り出し側の領域とする (取り出し側のコンテキストから呼び出す)
+     *
+     * @return bool 新しい値を受け取ったか
+     */
+    bool update() {
+        if ((Sync::loadFromConsumer(sharedState) & FreshFlag) == 0) {
+            return false;
+        }
+        readIndex = Sync::exchangeFromConsumer(sharedState, readIndex) & IndexMask;
+        internal::compilerBarrier();
+        return true;
+    }
+
+    /**
+     * @brief 取り出し側の領域を返す (取り出し側のコンテキストから呼び出す)
+     *
+     * @return const Element& 最後に受け取った値
+     * @note 次に `update` を呼び出すまで、追加側に書き換えられることはありません。
+     */
+    const Element& readSlot() const {
+        return internalData[readIndex];
+    }
+
+    /**
+     * @brief 新しい値が公開されていれば、それを受け取ってコピーする (取り出し側のコンテキストから呼び出す)
+     *
+     * @param data 受け取った値の格納先
+     * @return OperationResult 操作結果 (前回から新しい値が公開されていなければEmpty)
+     */
+    OperationResult read(Element* const data) {
+        if (!update()) {
+            return OperationResult::Empty;
+        }
+        *data = readSlot();
+        return OperationResult::Success;
+    }
+
+    /**
+     * @brief 取り出し側がまだ受け取っていない値があるか
+     *
+     * @return bool
+     */
+    bool hasUpdate() const {
+        return (Sync::loadFromConsumer(sharedState) & FreshFlag) != 0;
+    }
+};
+
+}  // namespace collection2
+
+#endif
@@ -0,0 +1,206 @@
+//
+// ワークスティーリング両端キュー (ホスト環境のみ)
+//
+
+#ifndef COLLECTION2_WORK_STEALING_DEQUE_H
+#define COLLECTION2_WORK_STEALING_DEQUE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+
+#include "common.hpp"
+
+namespace collection2 {
+
+/**
+ * @brief Chase-Lev方式のワークスティーリング両端キュー
+ *
+ * @tparam Element 要素の型 (タスクへのポインタやインデックスなど、ポインタ以下の大きさでトリビアルにコピー可能な型)
+ * @tparam Size 要素数の型 (符号なし整数)
+ *
+ * @note 所有者スレッドは `push`, `pop` で底 (bottom) 側をスタックのように操作し、他のスレッドは `steal` で頂上 (top) 側から要素を奪います。
+ *       所有者は一つのスレッドに限られますが、`steal` は任意の数のスレッドから同時に呼び出せます。
+ * @note 領域は拡張されないため、満杯の場合 `push` はOverflowを返します。
+ * @note 盗みは `top` を進める前に要素を読み出すため、その間に所有者が同じスロットへ書き込むことがあります。
+ *       競合する読み書きがデータ競合とならないよう、各スロットはアトミック変数とし、relaxedで読み書きします。
+ */
+template <typename Element, typename Size = size_t>
+class WorkStealingDeque {
+    static_assert(internal::IsTriviallyCopyable<Element>::value && sizeof(Element) <= sizeof(uintptr_t), "collection2::WorkStealingDeque: Element must be trivially copyable and no larger than a pointer");
+
+   private:
+    /**
+     * @brief 内部データ管理領域
+     */
+    std::atomic<Element>* const internalData;
+
+    /**
+     * @brief 内部データ長さ
+     */
+    Size internalDataSize;
+
+    /**
+     * @brief 頂上 (奪われる側、容量で丸めずに増え続ける)
+     */
+    alignas(COLLECTION2_CACHE_LINE_SIZE) std::atomic<Size> top;
+
+    /**
+     * @brief 底 (所有者側、容量で丸めずに増減する)
+     */
+    alignas(COLLECTION2_CACHE_LINE_SIZE) std::atomic<Size> bottom;
+
+   public:
+    /**
+     * @brief 内部データを扱う領域とそのサイズを指定して両端キューを初期化
+     *
+     * @param data 内部データ保管用領域
+     * @param dataSize 領域サイズ
+     * @note 領域サイズは2の冪乗であるべきです。それ以外の値を指定した場合、2の冪数のうち領域のサイズを下回らない最大のものが選択されます(15 -> 8, 34 -> 32).
+     */
+    WorkStealingDeque(std::atomic<Element>* const data, const Size& dataSize);
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    ~WorkStealingDeque() = default;
+
+    /**
+     * @brief 底にデータを追加 (所有者スレッドから呼び出す)
+     *
+     * @param data 追加するデータ
+     * @return OperationResult 操作結果
+     */
+    OperationResult push(const Element& data);
+
+    /**
+     * @brief 底からデータを取り出し (所有者スレッドから呼び出す)
+     *
+     * @param data 取り出したデータの格納先
+     * @return OperationResult 操作結果
+     */
+    OperationResult pop(Element* const data);
+
+    /**
+     * @brief 頂上からデータを奪う (任意のスレッドから呼び出せる)
+     *
+     * @param data 奪ったデータの格納先
+     * @return OperationResult 操作結果
+     * @note 他のスレッドと同じ要素を取り合って負けた場合もEmptyが返ります。必要であれば再度呼び出してください。
+     */
+    OperationResult steal(Element* const data);
+
+    /**
+     * @brief 両端キューの全体長を返す
+     *
+     * @return Size 両端キュー長
+     */
+    Size capacity() const {
+        return internalDataSize;
+    }
+
+    /**
+     * @brief 現在両端キュー内にあるデータ数を返す
+     *
+     * @return Size 両端キュー内に存在するデータの数
+     * @note 他のスレッドが操作している間は、呼び出した時点での近似値となります。
+     */
+    Size amount() const {
+        const Size t = top.load(std::memory_order_acquire);
+        const Size distance = bottom.load(std::memory_order_acquire) - t;
+        return distance <= internalDataSize ? distance : 0;
+    }
+
+    /**
+     * @brief 両端キューが空かどうか
+     *
+     * @return bool
+     */
+    bool isEmpty() const {
+        return amount() == 0;
+    }
+};
+
+template <typename Element, typename Size>
+WorkStealingDeque<Element, Size>::WorkStealingDeque(std::atomic<Element>* const data, const Size& dataSize)
+    : internalData(data), internalDataSize(internal::floorPowerOfTwo(dataSize)) {
+    top.store(0, std::memory_order_relaxed);
+    bottom.store(0, std::memory_order_relaxed);
+};
+
+template <typename Element, typename Size>
+OperationResult WorkStealingDeque<Element, Size>::push(const Element& data) {
+    const Size b = bottom.load(std::memory_order_relaxed);
+    const Size t = top.load(std::memory_order_acquire);
+
+    // 満杯なら戻る
+    if (static_cast<Size>(b - t) >= internalDataSize) {
+        return OperationResult::Overflow;
+    }
+
+    // 書き込んでからbottomを公開する
+    internalData[b & (internalDataSize - 1)].store(data, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom.store(b + 1, std::memory_order_relaxed);
+
+    return OperationResult::Success;
+}
+
+template <typename Element, typename Size>
+OperationResult WorkStealingDeque<Element, Size>::pop(Element* const data) {
+    // 先にbottomを下げて、以降の盗みと競合する要素を確定させる
+    const Size b = bottom.load(std::memory_order_relaxed) - 1;
+    bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    Size t = top.load(std::memory_order_relaxed);
+
+    // 空だった (b = t - 1 の場合、差は最大値になる)
+    if (static_cast<Size>(b - t) >= internalDataSize) {
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return OperationResult::Empty;
+    }
+
+    const Element value = internalData[b & (internalDataSize - 1)].load(std::memory_order_relaxed);
+    if (b != t) {
+        // 2つ以上残っていたので、盗みと競合しない
+        *data = value;
+        return OperationResult::Success;
+    }
+
+    // 最後の一つは盗みと取り合いになるので、topを進めて確保する 負けた場合は格納先を書き換えない
+    const bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    bottom.store(b + 1, std::memory_order_relaxed);
+    if (!won) {
+        return OperationResult::Empty;
+    }
+    *data = value;
+
+    return OperationResult::Success;
+}
+
+template <typename Element, typename Size>
+OperationResult WorkStealingDeque<Element, Size>::steal(Element* const data) {
+    Size t = top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const Size b = bottom.load(std::memory_order_acquire);
+
+    // 空なら戻る (所有者がpop中でbottomがtopを下回っている場合も含む)
+    const Size distance = b - t;
+    if (distance == 0 || distance > internalDataSize) {
+        return OperationResult::Empty;
+    }
+
+    // 読み出してからtopを進める 負けた場合、読み出した値は捨てる
+    const Element value = internalData[t & (internalDataSize - 1)].load(std::memory_order_relaxed);
+    if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        return OperationResult::Empty;
+    }
+    *data = value;
+
+    return OperationResult::Success;
+}
+
+}  // namespace collection2
+
+#endif
@@ -112,3 +112,24 @@ TEST(BufferTest, testOperateWithOneSize) {
     EXPECT_EQ(value, 2);
     EXPECT_EQ(buffer.pop(&value), OperationResult::Empty);
 }
+
+TEST(BufferTest, testExactCapacity) {
+    // 領域全体が容量として使用され、満杯なら先頭から上書きされる
+    using ExactBuffer = Buffer<int, size_t, SingleContext, ExactCapacity>;
+    const int bufferLength = 100;
+    int bufferData[bufferLength] = {0};
+    ExactBuffer buffer(bufferData, bufferLength);
+    EXPECT_EQ(buffer.capacity(), 100);
+
+    for (int i = 0; i < 150; i++) {
+        EXPECT_EQ(buffer.append(i), OperationResult::Success);
+    }
+    EXPECT_EQ(buffer.amount(), 100);
+
+    for (int i = 50; i < 150; i++) {
+        int value = 0;
+        EXPECT_EQ(buffer.pop(&value), OperationResult::Success);
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_TRUE(buffer.isEmpty());
+}
@@ -0,0 +1,174 @@
+//
+// 複数のスレッドで共有するオブジェクトプールのテスト
+//
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "collection2/concurrent_pool.hpp"
+#include "collection2/list.hpp"
+#include "collection2/tree.hpp"
+
+using namespace collection2;
+
+namespace {
+using SharedNodePool = Pool<TreeNode<int>, size_t, LockFree>;
+using SharedTree = Tree<int, size_t, false, NoAugmentation, LockFree>;
+using SharedListPool = Pool<Node<int>, size_t, LockFree>;
+using SharedList = List<int, size_t, LockFree>;
+
+/// 中間順に辿ったときに整列しているか
+bool isSorted(const TreeNode<int>* node, int& previous) {
+    if (node == nullptr) {
+        return true;
+    }
+    if (!isSorted(node->lhs, previous) || node->element < previous) {
+        return false;
+    }
+    previous = node->element;
+    return isSorted(node->rhs, previous);
+}
+}  // namespace
+
+TEST(ConcurrentPoolTest, testAcquireAndRelease) {
+    int64_t data[4] = {0};
+    std::atomic<uint32_t> links[4];
+    Pool<int64_t, size_t, LockFree> pool(data, 4, links);
+    EXPECT_EQ(pool.capacity(), 4);
+
+    // 払い出しと返却はシングルスレッドのプールと同様に振る舞う
+    int64_t* objects[4] = {nullptr};
+    for (int i = 0; i < 4; i++) {
+        objects[i] = pool.acquire(i);
+        ASSERT_NE(objects[i], nullptr);
+        EXPECT_EQ(*objects[i], i);
+    }
+    EXPECT_EQ(pool.acquire(), nullptr);
+    EXPECT_FALSE(pool.hasSpace());
+
+    EXPECT_EQ(pool.release(objects[2]), OperationResult::Success);
+    int64_t outside = 0;
+    EXPECT_EQ(pool.release(&outside), OperationResult::Empty);
+    EXPECT_EQ(pool.amount(), 3);
+    EXPECT_EQ(pool.acquire(), objects[2]);
+
+    pool.reset();
+    EXPECT_TRUE(pool.isEmpty());
+
+    // リンク保管用領域がなければ容量0として扱われる
+    Pool<int64_t, size_t, LockFree> unlinked(data, 4, nullptr);
+    EXPECT_EQ(unlinked.capacity(), 0);
+    EXPECT_EQ(unlinked.acquire(), nullptr);
+}
+
+TEST(ConcurrentPoolTest, testContainersHoldOnlyPoolPointer) {
+    // LockFreeポリシーのリスト・ツリーは共有プールへのポインタだけを持つ
+    EXPECT_EQ(sizeof(SharedTree), sizeof(void*));
+    EXPECT_EQ(sizeof(SharedList), sizeof(void*) * 3 + sizeof(size_t));
+
+    Node<int> nodes[8];
+    std::atomic<uint32_t> links[8];
+    SharedListPool pool(nodes, 8, links);
+    SharedList list(pool);
+    for (int i = 0; i < 8; i++) {
+        EXPECT_EQ(list.append(i), OperationResult::Success);
+    }
+    EXPECT_EQ(list.capacity(), 8);
+    EXPECT_EQ(list.append(8), OperationResult::Overflow);
+}
+
+TEST(ConcurrentPoolTest, testParallelTreeConstruction) {
+    // 各スレッドが共有プールから自分のツリーを構築しては壊す
+    const int threadCount = 4;
+    const int treeSize = 500;
+    const int rounds = 200;
+    std::vector<TreeNode<int>> nodes(threadCount * treeSize);
+    std::vector<std::atomic<uint32_t>> links(nodes.size());
+    SharedNodePool pool(nodes.data(), nodes.size(), links.data());
+
+    std::vector<int> sorted(treeSize);
+    for (int i = 0; i < treeSize; i++) {
+        sorted[i] = i * 2;
+    }
+
+    std::atomic<int> failures(0);
+    std::thread workers[threadCount];
+    for (auto& worker : workers) {
+        worker = std::thread([&]() {
+            SharedTree tree(pool);
+            for (int round = 0; round < rounds; round++) {
+                // 一括構築と、一つずつの追加を交互に行う
+                TreeNode<int>* root = nullptr;
+                if (round % 2 == 0) {
+                    if (tree.buildBalanced(sorted.data(), treeSize, &root) != OperationResult::Success) {
+                        failures++;
+                        continue;
+                    }
+                } else {
+                    root = tree.retainNode(sorted[0]);
+                    auto* node = root;
+                    for (int i = 1; i < treeSize && node != nullptr; i++) {
+                        TreeNode<int>* added = nullptr;
+                        tree.appendChild(node, sorted[i], TreeNodeSide::Right, &added);
+                        node = added;
+                    }
+                    if (node == nullptr) {
+                        failures++;
+                    }
+                }
+
+                int previous = -1;
+                if (!isSorted(root, previous) || previous != sorted[treeSize - 1]) {
+                    failures++;
+                }
+                tree.removeChild(root);
+                tree.removeChild(root);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    EXPECT_EQ(failures.load(), 0);
+    EXPECT_TRUE(pool.isEmpty());
+}
+
+TEST(ConcurrentPoolTest, testParallelLists) {
+    const int threadCount = 4;
+    const int listSize = 100;
+    std::vector<Node<int>> nodes(threadCount * listSize);
+    std::vector<std::atomic<uint32_t>> links(nodes.size());
+    SharedListPool pool(nodes.data(), nodes.size(), links.data());
+
+    std::atomic<int> failures(0);
+    std::thread workers[threadCount];
+    for (int t = 0; t < threadCount; t++) {
+        workers[t] = std::thread([&, t]() {
+            SharedList list(pool);
+            for (int round = 0; round < 500; round++) {
+                for (int i = 0; i < listSize; i++) {
+                    if (list.append(t * 1000 + i) != OperationResult::Success) {
+                        failures++;
+                    }
+                }
+                for (int i = 0; i < listSize; i++) {
+                    int value = 0;
+                    if (list.remove(0, &value) != OperationResult::Success || value != t * 1000 + i) {
+                        failures++;
+                    }
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    EXPECT_EQ(failures.load(), 0);
+    EXPECT_TRUE(pool.isEmpty());
+}
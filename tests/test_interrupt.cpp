@@ -0,0 +1,152 @@
+//
+// 割り込みハンドラと共有するキュー・リングバッファのテスト
+//
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+
+#include "collection2/interrupt.hpp"
+
+using namespace collection2;
+
+TEST(InterruptTest, testQueueCapacityAndAmount) {
+    int data[10] = {0};
+    Queue<int, uint8_t, InterruptToMain> queue(data, 10);
+    EXPECT_EQ(queue.capacity(), 8);
+
+    queue.enqueue(1);
+    queue.enqueue(2);
+    queue.enqueue(3);
+    EXPECT_EQ(queue.amount(), 3);
+    EXPECT_TRUE(queue.hasSpace());
+}
+
+TEST(InterruptTest, testQueueWrapAround) {
+    // 1バイトのインデックスが何周しても正しく動作する
+    char data[128] = {0};
+    Queue<char, uint8_t, MainToInterrupt> queue(data, sizeof(data));
+    EXPECT_EQ(queue.capacity(), 128);
+
+    for (int round = 0; round < 10; round++) {
+        for (int i = 0; i < 128; i++) {
+            EXPECT_EQ(queue.enqueue(static_cast<char>(round + i)), OperationResult::Success);
+        }
+        EXPECT_EQ(queue.enqueue(0), OperationResult::Overflow);
+        EXPECT_FALSE(queue.hasSpace());
+
+        for (int i = 0; i < 100; i++) {
+            char value = 0;
+            EXPECT_EQ(queue.dequeue(&value), OperationResult::Success);
+            EXPECT_EQ(value, static_cast<char>(round + i));
+        }
+        for (int i = 100; i < 128; i++) {
+            char value = 0;
+            EXPECT_EQ(queue.dequeue(&value), OperationResult::Success);
+            EXPECT_EQ(value, static_cast<char>(round + i));
+        }
+        EXPECT_TRUE(queue.isEmpty());
+    }
+}
+
+TEST(InterruptTest, testQueueConsume) {
+    char data[16] = {0};
+    Queue<char, uint8_t, InterruptToMain> queue(data, sizeof(data));
+
+    // 1バイトのインデックスが何周しても、まとめて処理できる
+    char expected = 0;
+    bool isOrdered = true;
+    for (int round = 0; round < 40; round++) {
+        for (int i = 0; i < 10; i++) {
+            queue.enqueue(static_cast<char>(round * 10 + i));
+        }
+        EXPECT_EQ(queue.consume(4, [&](char& value) { isOrdered = isOrdered && value == expected++; }), 4);
+        EXPECT_EQ(queue.consumeAll([&](char& value) { isOrdered = isOrdered && value == expected++; }), 6);
+    }
+    EXPECT_TRUE(isOrdered);
+    EXPECT_TRUE(queue.isEmpty());
+}
+
+TEST(InterruptTest, testQueueWithZeroSize) {
+    Queue<int, uint16_t, InterruptToMain> queue(nullptr, 0);
+
+    int value = 1;
+    EXPECT_EQ(queue.enqueue(value), OperationResult::Overflow);
+    EXPECT_EQ(queue.dequeue(&value), OperationResult::Empty);
+}
+
+TEST(InterruptTest, testBufferOverwrite) {
+    int data[4] = {0};
+    Buffer<int, uint16_t, InterruptToMain> fromInterrupt(data, 4);
+    int otherData[4] = {0};
+    Buffer<int, uint16_t, MainToInterrupt> fromMain(otherData, 4);
+
+    // 満杯で追加すると古いものから捨てられる
+    for (int i = 0; i < 6; i++) {
+        EXPECT_EQ(fromInterrupt.append(i + 1), OperationResult::Success);
+        EXPECT_EQ(fromMain.append(i + 1), OperationResult::Success);
+    }
+    EXPECT_EQ(fromInterrupt.amount(), 4);
+    EXPECT_EQ(fromMain.amount(), 4);
+
+    for (int i = 2; i < 6; i++) {
+        int value = 0;
+        EXPECT_EQ(fromInterrupt.pop(&value), OperationResult::Success);
+        EXPECT_EQ(value, i + 1);
+        EXPECT_EQ(fromMain.pop(&value), OperationResult::Success);
+        EXPECT_EQ(value, i + 1);
+    }
+    EXPECT_EQ(fromInterrupt.pop(nullptr), OperationResult::Empty);
+    EXPECT_EQ(fromMain.pop(nullptr), OperationResult::Empty);
+}
+
+TEST(InterruptTest, testBufferWithZeroSize) {
+    Buffer<int, uint8_t, InterruptToMain> buffer(nullptr, 0);
+
+    int value = 1;
+    EXPECT_EQ(buffer.append(value), OperationResult::Overflow);
+    EXPECT_EQ(buffer.pop(&value), OperationResult::Empty);
+}
+
+TEST(InterruptTest, testExactCapacity) {
+    // 領域全体を使用し、インデックスは容量の2倍の範囲を巡回する
+    char data[100] = {0};
+    Queue<char, uint8_t, InterruptToMain, ExactCapacity> queue(data, sizeof(data));
+    EXPECT_EQ(queue.capacity(), 100);
+
+    for (int round = 0; round < 10; round++) {
+        for (int i = 0; i < 100; i++) {
+            EXPECT_EQ(queue.enqueue(static_cast<char>(round + i)), OperationResult::Success);
+        }
+        EXPECT_EQ(queue.enqueue(0), OperationResult::Overflow);
+
+        char expected = static_cast<char>(round);
+        bool isOrdered = true;
+        EXPECT_EQ(queue.consume(30, [&](char& value) { isOrdered = isOrdered && value == expected++; }), 30);
+        for (int i = 30; i < 100; i++) {
+            char value = 0;
+            EXPECT_EQ(queue.dequeue(&value), OperationResult::Success);
+            isOrdered = isOrdered && value == expected++;
+        }
+        EXPECT_TRUE(isOrdered);
+        EXPECT_TRUE(queue.isEmpty());
+    }
+
+    // バッファも満杯時の上書きを含めて同様に動作する
+    int bufferData[6] = {0};
+    Buffer<int, uint8_t, MainToInterrupt, ExactCapacity> buffer(bufferData, 6);
+    for (int i = 0; i < 50; i++) {
+        EXPECT_EQ(buffer.append(i), OperationResult::Success);
+    }
+    EXPECT_EQ(buffer.amount(), 6);
+    for (int i = 44; i < 50; i++) {
+        int value = 0;
+        EXPECT_EQ(buffer.pop(&value), OperationResult::Success);
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_TRUE(buffer.isEmpty());
+
+    // インデックスが容量の2倍を表せるよう、容量はSizeの最大値の半分までとなる
+    char largeData[255] = {0};
+    Queue<char, uint8_t, InterruptToMain, ExactCapacity> large(largeData, sizeof(largeData));
+    EXPECT_EQ(large.capacity(), 127);
+}
@@ -233,3 +233,164 @@ TEST(ListTest, testOperateWithOneSize) {
     EXPECT_EQ(list.remove(0, &value), OperationResult::Empty);
     EXPECT_EQ(list.remove(1, &value), OperationResult::Empty);
 }
+
+// 先頭・末尾の削除後もノードの接続が保たれる
+TEST(ListTest, testLinksAfterDeletion) {
+    const int listLength = 5;
+    Node<int> listData[listLength];
+    List<int> list(listData, listLength);
+
+    for (int i = 0; i < listLength; i++) {
+        list.append(i + 1);
+    }
+    list.insert(0, 0);  // 満杯なので失敗する
+    list.pop(nullptr);
+    list.remove(0, nullptr);
+    list.insert(0, 1);  // 1, 2, 3, 4
+
+    EXPECT_EQ(list.head()->previous, nullptr);
+    EXPECT_EQ(list.tail()->next, nullptr);
+
+    // 後ろから辿っても同じ並びになる
+    auto* node = list.tail();
+    int expect = 4;
+    while (node != nullptr) {
+        EXPECT_EQ(node->element, expect);
+        expect--;
+        node = node->previous;
+    }
+    EXPECT_EQ(expect, 0);
+}
+
+// ソート
+TEST(ListTest, testSort) {
+    const int listLength = 100;
+    Node<int> listData[listLength];
+    List<int> list(listData, listLength);
+
+    // 適当な順番で追加
+    for (int i = 0; i < listLength; i++) {
+        list.append((i * 37) % listLength);
+    }
+
+    list.sort();
+
+    // 前から辿っても後ろから辿っても整列している
+    auto* node = list.head();
+    for (int i = 0; i < listLength; i++) {
+        ASSERT_NE(node, nullptr);
+        EXPECT_EQ(node->element, i);
+        node = node->next;
+    }
+    EXPECT_EQ(node, nullptr);
+
+    node = list.tail();
+    for (int i = listLength - 1; i >= 0; i--) {
+        ASSERT_NE(node, nullptr);
+        EXPECT_EQ(node->element, i);
+        node = node->previous;
+    }
+    EXPECT_EQ(node, nullptr);
+    EXPECT_EQ(list.amount(), listLength);
+}
+
+// 比較関数を指定したソート (安定性の確認)
+TEST(ListTest, testSortStable) {
+    struct Entry {
+        int key;
+        int order;
+    };
+    const int listLength = 30;
+    Node<Entry> listData[listLength];
+    List<Entry> list(listData, listLength);
+
+    for (int i = 0; i < listLength; i++) {
+        list.append({i % 3, i});
+    }
+
+    // keyの降順に並べる
+    list.sort([](const Entry& lhs, const Entry& rhs) { return lhs.key > rhs.key; });
+
+    // keyが等しいものは追加順を保つ
+    auto* node = list.head();
+    for (int key = 2; key >= 0; key--) {
+        for (int i = 0; i < listLength / 3; i++) {
+            ASSERT_NE(node, nullptr);
+            EXPECT_EQ(node->element.key, key);
+            EXPECT_EQ(node->element.order, key + i * 3);
+            node = node->next;
+        }
+    }
+}
+
+// 整列済みリストへの追加
+TEST(ListTest, testInsertSorted) {
+    const int listLength = 10;
+    Node<int> listData[listLength];
+    List<int> list(listData, listLength);
+
+    // 空のリストでもソートできる
+    list.sort();
+
+    int values[] = {5, 1, 9, 3, 7, 3, 0, 8, 2, 6};
+    for (int i = 0; i < listLength; i++) {
+        EXPECT_EQ(list.insertSorted(values[i]), OperationResult::Success);
+    }
+    EXPECT_EQ(list.insertSorted(4), OperationResult::Overflow);
+
+    int expected[] = {0, 1, 2, 3, 3, 5, 6, 7, 8, 9};
+    for (int i = 0; i < listLength; i++) {
+        EXPECT_EQ(*list.get(i), expected[i]);
+    }
+    EXPECT_EQ(list.tail()->element, 9);
+    EXPECT_EQ(list.tail()->previous->element, 8);
+}
+
+TEST(ListTest, testSharedPool) {
+    // 4本のリストで8ノードを共有する
+    Node<int> nodes[8];
+    Pool<Node<int>> pool(nodes, 8);
+    List<int, size_t, SharedPool> channel0(pool), channel1(pool), channel2(pool), channel3(pool);
+    List<int, size_t, SharedPool>* lists[] = {&channel0, &channel1, &channel2, &channel3};
+
+    // 共有プールを使うリストはプールへのポインタだけを持つ
+    EXPECT_EQ(sizeof(channel0), sizeof(void*) * 3 + sizeof(size_t));
+
+    // 一つのリストが偏って使っても、合計が収まればよい
+    for (int i = 0; i < 6; i++) {
+        EXPECT_EQ(lists[0]->append(i), OperationResult::Success);
+    }
+    EXPECT_EQ(lists[1]->append(100), OperationResult::Success);
+    EXPECT_EQ(lists[2]->append(200), OperationResult::Success);
+    EXPECT_EQ(lists[3]->append(300), OperationResult::Overflow);
+    EXPECT_EQ(pool.amount(), 8);
+    EXPECT_EQ(lists[0]->capacity(), 8);
+
+    // 削除したノードは他のリストで再利用できる
+    int value = 0;
+    EXPECT_EQ(lists[0]->pop(&value), OperationResult::Success);
+    EXPECT_EQ(lists[3]->append(300), OperationResult::Success);
+    EXPECT_EQ(*lists[3]->get(0), 300);
+
+    // clearで全ノードを返却する
+    lists[0]->clear();
+    EXPECT_EQ(lists[0]->amount(), 0);
+    EXPECT_EQ(lists[0]->head(), nullptr);
+    EXPECT_EQ(pool.amount(), 3);
+    EXPECT_EQ(*lists[1]->get(0), 100);
+    EXPECT_EQ(*lists[2]->get(0), 200);
+}
+
+TEST(ListTest, testSharedPoolReleaseOnDestruction) {
+    Node<int> nodes[4];
+    Pool<Node<int>> pool(nodes, 4);
+    {
+        List<int, size_t, SharedPool> list(pool);
+        list.append(1);
+        list.append(2);
+        EXPECT_EQ(pool.amount(), 2);
+    }
+
+    // 破棄されたリストのノードはプールに戻る
+    EXPECT_EQ(pool.amount(), 0);
+}
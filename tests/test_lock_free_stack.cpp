@@ -0,0 +1,105 @@
+//
+// ロックフリースタックのテスト
+//
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <thread>
+
+#include "collection2/lock_free_stack.hpp"
+
+using namespace collection2;
+
+TEST(LockFreeStackTest, testOperate) {
+    const int stackLength = 8;
+    LockFreeStackNode<int> nodes[stackLength];
+    LockFreeStack<int> stack(nodes, stackLength);
+    EXPECT_EQ(stack.capacity(), 8);
+    EXPECT_TRUE(stack.isEmpty());
+
+    // 何度積み直しても後入れ先出しで取り出せる
+    for (int round = 0; round < 10; round++) {
+        for (int i = 0; i < stackLength; i++) {
+            EXPECT_EQ(stack.push(round * 100 + i), OperationResult::Success);
+        }
+        EXPECT_FALSE(stack.hasSpace());
+        EXPECT_EQ(stack.push(0), OperationResult::Overflow);
+
+        for (int i = stackLength - 1; i >= 0; i--) {
+            int value = 0;
+            EXPECT_EQ(stack.pop(&value), OperationResult::Success);
+            EXPECT_EQ(value, round * 100 + i);
+        }
+        EXPECT_TRUE(stack.isEmpty());
+        EXPECT_TRUE(stack.hasSpace());
+
+        int value = 0;
+        EXPECT_EQ(stack.pop(&value), OperationResult::Empty);
+    }
+}
+
+TEST(LockFreeStackTest, testOperateWithZeroSize) {
+    LockFreeStack<int> stack(nullptr, 0);
+
+    int value = 1;
+    EXPECT_EQ(stack.push(value), OperationResult::Overflow);
+    EXPECT_EQ(stack.pop(&value), OperationResult::Empty);
+}
+
+TEST(LockFreeStackTest, testConcurrentPushAndPop) {
+    // 複数のスレッドが同じスタックに空きバッファの番号を出し入れする
+    const int bufferCount = 64;
+    const int threadCount = 4;
+    const int iterations = 100000;
+    LockFreeStackNode<int> nodes[bufferCount];
+    LockFreeStack<int> stack(nodes, bufferCount);
+    for (int i = 0; i < bufferCount; i++) {
+        ASSERT_EQ(stack.push(i), OperationResult::Success);
+    }
+
+    // 同じ番号を二つのスレッドが同時に持つことはない
+    std::atomic<int> owners[bufferCount];
+    for (auto& owner : owners) {
+        owner.store(0);
+    }
+    std::atomic<int> conflicts(0);
+
+    std::thread workers[threadCount];
+    for (auto& worker : workers) {
+        worker = std::thread([&]() {
+            int held[4] = {0};
+            for (int i = 0; i < iterations; i++) {
+                // 一度に最大4つまで借りてから返す
+                int heldCount = 0;
+                while (heldCount < 4 && stack.pop(&held[heldCount]) == OperationResult::Success) {
+                    if (owners[held[heldCount]].fetch_add(1) != 0) {
+                        conflicts++;
+                    }
+                    heldCount++;
+                }
+                while (heldCount > 0) {
+                    heldCount--;
+                    owners[held[heldCount]].fetch_sub(1);
+                    EXPECT_EQ(stack.push(held[heldCount]), OperationResult::Success);
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    EXPECT_EQ(conflicts.load(), 0);
+
+    // 最後には全ての番号がちょうど一度ずつ戻っている
+    bool returned[bufferCount] = {false};
+    int value = 0;
+    int count = 0;
+    while (stack.pop(&value) == OperationResult::Success) {
+        EXPECT_FALSE(returned[value]);
+        returned[value] = true;
+        count++;
+    }
+    EXPECT_EQ(count, bufferCount);
+}
@@ -0,0 +1,156 @@
+//
+// LRUキャッシュのテスト
+//
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+
+#include <list>
+#include <utility>
+
+#include "collection2/lru_cache.hpp"
+
+using namespace collection2;
+
+TEST(LruCacheTest, testCapacity) {
+    LruCacheNode<int, int> nodes[8];
+    size_t table[10];
+    LruCache<int, int> cache(nodes, 8, table, 10);
+
+    // ハッシュ表の大きさは2の冪数に丸められ、一つは必ず空けておく
+    EXPECT_EQ(cache.capacity(), 7);
+    EXPECT_TRUE(cache.isEmpty());
+
+    LruCache<int, int> zeroCache(nullptr, 0, nullptr, 0);
+    EXPECT_EQ(zeroCache.put(1, 1), OperationResult::Overflow);
+    EXPECT_EQ(zeroCache.get(1), nullptr);
+}
+
+TEST(LruCacheTest, testGetAndPut) {
+    LruCacheNode<int, int> nodes[3];
+    size_t table[8];
+    LruCache<int, int> cache(nodes, 3, table, 8);
+
+    EXPECT_EQ(cache.put(1, 10), OperationResult::Success);
+    EXPECT_EQ(cache.put(2, 20), OperationResult::Success);
+    EXPECT_EQ(cache.put(3, 30), OperationResult::Success);
+    EXPECT_EQ(*cache.get(1), 10);
+
+    // 最も長く使われていない2が追い出される
+    EXPECT_EQ(cache.put(4, 40), OperationResult::Success);
+    EXPECT_EQ(cache.amount(), 3);
+    EXPECT_EQ(cache.get(2), nullptr);
+    EXPECT_EQ(*cache.get(3), 30);
+
+    // 上書きしても数は変わらず、最も最近使われたものになる
+    EXPECT_EQ(cache.put(1, 11), OperationResult::Success);
+    EXPECT_EQ(cache.amount(), 3);
+    const int expectedOrder[] = {4, 3, 1};
+    int index = 0;
+    for (auto* node = cache.head(); node != nullptr; node = node->next) {
+        EXPECT_EQ(node->element.key, expectedOrder[index++]);
+    }
+
+    // peekは使用順を変えない
+    EXPECT_EQ(*cache.peek(4), 40);
+    EXPECT_EQ(cache.head()->element.key, 4);
+
+    int removed = 0;
+    EXPECT_EQ(cache.remove(3, &removed), OperationResult::Success);
+    EXPECT_EQ(removed, 30);
+    EXPECT_EQ(cache.remove(3), OperationResult::Empty);
+    EXPECT_EQ(cache.peek(3), nullptr);
+}
+
+namespace {
+struct Evictions {
+    int keys[8];
+    int count;
+};
+
+void recordEviction(const int& key, int& value, void* context) {
+    auto* evictions = static_cast<Evictions*>(context);
+    evictions->keys[evictions->count++] = key;
+    value = -1;
+}
+}  // namespace
+
+TEST(LruCacheTest, testEvictionCallback) {
+    LruCacheNode<int, int> nodes[2];
+    size_t table[4];
+    LruCache<int, int> cache(nodes, 2, table, 4);
+    Evictions evictions = {{0}, 0};
+    cache.setEvictionCallback(recordEviction, &evictions);
+
+    cache.put(1, 1);
+    cache.put(2, 2);
+    cache.get(1);
+    cache.put(3, 3);
+    cache.put(4, 4);
+
+    // 追い出されたときだけ呼ばれる
+    cache.remove(4);
+    cache.clear();
+    ASSERT_EQ(evictions.count, 2);
+    EXPECT_EQ(evictions.keys[0], 2);
+    EXPECT_EQ(evictions.keys[1], 1);
+}
+
+namespace {
+struct CollidingHash {
+    uint32_t operator()(const int& key) const {
+        return static_cast<uint32_t>(key % 3);
+    }
+};
+}  // namespace
+
+TEST(LruCacheTest, testRandomOperationsMatchReference) {
+    // ハッシュ値が衝突しやすい状態で、削除後の詰め直しを含めて参照実装と比較する
+    const int length = 12;
+    LruCacheNode<int, int, uint8_t> nodes[length];
+    uint8_t table[16];
+    LruCache<int, int, uint8_t, CollidingHash> cache(nodes, length, table, 16);
+    std::list<std::pair<int, int>> reference;  // 先頭が最も長く使われていないもの
+
+    uint32_t seed = 3;
+    for (int step = 0; step < 5000; step++) {
+        seed = seed * 1103515245 + 12345;
+        const int key = static_cast<int>((seed >> 16) % 24);
+        const int operation = static_cast<int>((seed >> 8) % 3);
+        auto position = reference.begin();
+        while (position != reference.end() && position->first != key) {
+            position++;
+        }
+
+        if (operation == 0) {
+            ASSERT_EQ(cache.put(key, step), OperationResult::Success);
+            if (position != reference.end()) {
+                reference.erase(position);
+            } else if (reference.size() == length) {
+                reference.pop_front();
+            }
+            reference.emplace_back(key, step);
+        } else if (operation == 1) {
+            auto* value = cache.get(key);
+            if (position == reference.end()) {
+                ASSERT_EQ(value, nullptr);
+            } else {
+                ASSERT_NE(value, nullptr);
+                ASSERT_EQ(*value, position->second);
+                reference.splice(reference.end(), reference, position);
+            }
+        } else {
+            ASSERT_EQ(cache.remove(key), position != reference.end() ? OperationResult::Success : OperationResult::Empty);
+            if (position != reference.end()) {
+                reference.erase(position);
+            }
+        }
+
+        ASSERT_EQ(cache.amount(), reference.size());
+        auto expected = reference.begin();
+        for (auto* node = cache.head(); node != nullptr; node = node->next, expected++) {
+            ASSERT_EQ(node->element.key, expected->first);
+            ASSERT_EQ(*cache.peek(expected->first), expected->second);
+        }
+    }
+}
@@ -0,0 +1,114 @@
+//
+// ミラーリングされたリングバッファのテスト
+//
+
+#if defined(__linux__)
+
+#include <gtest/gtest.h>
+#include <string.h>
+
+#include "collection2/mirrored_buffer.hpp"
+
+using namespace collection2;
+
+TEST(MirroredBufferTest, testMirroredRegion) {
+    MirroredRegion region;
+    ASSERT_TRUE(region.map(100, sizeof(int)));
+
+    // ページサイズの倍数に切り上げられる
+    const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    EXPECT_EQ(region.size() % pageSize, 0);
+    EXPECT_GE(region.size(), 100);
+
+    // 後半のミラーにも同じ内容が見える
+    auto* bytes = static_cast<unsigned char*>(region.data());
+    bytes[0] = 0x12;
+    EXPECT_EQ(bytes[region.size()], 0x12);
+    bytes[region.size() + 1] = 0x34;
+    EXPECT_EQ(bytes[1], 0x34);
+}
+
+TEST(MirroredBufferTest, testMirroredRegionWithOddUnit) {
+    // 要素の大きさがページサイズを割り切らない場合も、要素の境界で折り返せる大きさになる
+    MirroredRegion region;
+    ASSERT_TRUE(region.map(1, 12));
+    EXPECT_EQ(region.size() % 12, 0);
+}
+
+TEST(MirroredBufferTest, testAppendAndPop) {
+    MirroredRegion region;
+    ASSERT_TRUE(region.map(1, sizeof(int)));
+    MirroredBuffer<int> buffer(region);
+    const int capacity = static_cast<int>(buffer.capacity());
+
+    // 満杯で追加すると先頭から捨てられる
+    for (int i = 0; i < capacity + 3; i++) {
+        EXPECT_EQ(buffer.append(i), OperationResult::Success);
+    }
+    EXPECT_EQ(buffer.amount(), capacity);
+    for (int i = 3; i < capacity + 3; i++) {
+        int value = -1;
+        EXPECT_EQ(buffer.pop(&value), OperationResult::Success);
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_EQ(buffer.pop(nullptr), OperationResult::Empty);
+}
+
+TEST(MirroredBufferTest, testContiguousAccessAcrossWrap) {
+    MirroredRegion region;
+    ASSERT_TRUE(region.map(1));
+    MirroredBuffer<char> buffer(region);
+    const size_t capacity = buffer.capacity();
+
+    // 折り返し位置の直前まで進めておく
+    ASSERT_EQ(buffer.commit(capacity - 4), OperationResult::Success);
+    ASSERT_EQ(buffer.consume(capacity - 4), OperationResult::Success);
+
+    // 折り返しをまたいで一度に書き込める
+    const char frame[] = "frame-across-wrap";
+    EXPECT_GE(capacity - buffer.amount(), sizeof(frame));
+    memcpy(buffer.writableData(), frame, sizeof(frame));
+    EXPECT_EQ(buffer.commit(sizeof(frame)), OperationResult::Success);
+
+    // 折り返しをまたいで一度に読める
+    EXPECT_EQ(buffer.amount(), sizeof(frame));
+    EXPECT_STREQ(buffer.readableData(), frame);
+
+    // 1要素ずつ取り出しても同じ内容
+    for (size_t i = 0; i < sizeof(frame); i++) {
+        char value = 0;
+        EXPECT_EQ(buffer.pop(&value), OperationResult::Success);
+        EXPECT_EQ(value, frame[i]);
+    }
+
+    // 範囲外の確定・読み捨て
+    EXPECT_EQ(buffer.consume(1), OperationResult::Empty);
+    EXPECT_EQ(buffer.commit(capacity + 1), OperationResult::Overflow);
+}
+
+TEST(MirroredBufferTest, testRegionTooLargeForSize) {
+    // 要素数がSizeで表せない領域は容量0として扱う
+    MirroredRegion region;
+    ASSERT_TRUE(region.map(256));
+    MirroredBuffer<char, uint8_t> narrow(region);
+    EXPECT_EQ(narrow.capacity(), 0);
+    EXPECT_EQ(narrow.append('a'), OperationResult::Overflow);
+
+    MirroredBuffer<char, uint16_t> wide(region);
+    EXPECT_EQ(wide.capacity(), region.size());
+}
+
+TEST(MirroredBufferTest, testIndicesNearSizeLimit) {
+    // 容量がSizeの上限に近くても位置の計算が溢れない
+    char data[255 * 2] = {0};
+    MirroredBuffer<char, uint8_t> buffer(data, 255);
+    ASSERT_EQ(buffer.commit(200), OperationResult::Success);
+    ASSERT_EQ(buffer.consume(150), OperationResult::Success);
+    ASSERT_EQ(buffer.commit(200), OperationResult::Success);
+
+    EXPECT_EQ(buffer.amount(), 250);
+    EXPECT_EQ(buffer.readableData(), data + 150);
+    EXPECT_EQ(buffer.writableData(), data + 145);
+}
+
+#endif
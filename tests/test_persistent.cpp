@@ -0,0 +1,133 @@
+//
+// 永続化キュー・リングバッファのテスト
+//
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "collection2/mapped_file.hpp"
+#include "collection2/persistent.hpp"
+
+using namespace collection2;
+
+TEST(PersistentTest, testCapacityAndAmount) {
+    // ヘッダを除いて int 10個分の領域
+    alignas(8) unsigned char region[sizeof(internal::PersistentRingHeader<size_t>) + sizeof(int) * 10] = {0};
+    PersistentQueue<int> queue(region, sizeof(region));
+
+    EXPECT_FALSE(queue.isRestored());
+    EXPECT_EQ(queue.capacity(), 8);
+
+    queue.enqueue(1);
+    queue.enqueue(2);
+    queue.enqueue(3);
+    EXPECT_EQ(queue.amount(), 3);
+}
+
+TEST(PersistentTest, testQueueRestore) {
+    alignas(8) unsigned char region[256] = {0};
+    {
+        PersistentQueue<int, uint16_t> queue(region, sizeof(region));
+        EXPECT_FALSE(queue.isRestored());
+
+        // 満杯まで追加
+        for (int i = 0; i < queue.capacity(); i++) {
+            EXPECT_EQ(queue.enqueue(i + 1), OperationResult::Success);
+        }
+        EXPECT_EQ(queue.enqueue(0), OperationResult::Overflow);
+
+        int value = 0;
+        EXPECT_EQ(queue.dequeue(&value), OperationResult::Success);
+        EXPECT_EQ(value, 1);
+    }
+
+    // 同じ領域を渡すと、続きから復元される
+    PersistentQueue<int, uint16_t> queue(region, sizeof(region));
+    EXPECT_TRUE(queue.isRestored());
+    EXPECT_EQ(queue.amount(), queue.capacity() - 1);
+    for (int i = 1; i < queue.capacity(); i++) {
+        int value = 0;
+        EXPECT_EQ(queue.dequeue(&value), OperationResult::Success);
+        EXPECT_EQ(value, i + 1);
+    }
+    EXPECT_TRUE(queue.isEmpty());
+
+    // 要素の型が異なる場合は初期化し直される
+    PersistentQueue<int64_t, uint16_t> otherQueue(region, sizeof(region));
+    EXPECT_FALSE(otherQueue.isRestored());
+    EXPECT_TRUE(otherQueue.isEmpty());
+}
+
+TEST(PersistentTest, testBufferOverwrite) {
+    alignas(8) unsigned char region[sizeof(internal::PersistentRingHeader<size_t>) + sizeof(int) * 4] = {0};
+    {
+        PersistentBuffer<int> buffer(region, sizeof(region));
+        EXPECT_EQ(buffer.capacity(), 4);
+
+        // 満杯で追加すると古いものから捨てられる
+        for (int i = 0; i < 6; i++) {
+            EXPECT_EQ(buffer.append(i + 1), OperationResult::Success);
+        }
+    }
+
+    PersistentBuffer<int> buffer(region, sizeof(region));
+    EXPECT_TRUE(buffer.isRestored());
+    for (int i = 2; i < 6; i++) {
+        int value = 0;
+        EXPECT_EQ(buffer.pop(&value), OperationResult::Success);
+        EXPECT_EQ(value, i + 1);
+    }
+    EXPECT_EQ(buffer.pop(nullptr), OperationResult::Empty);
+}
+
+TEST(PersistentTest, testOperateWithTooSmallRegion) {
+    // ヘッダすら収まらない領域
+    alignas(8) unsigned char region[4] = {0};
+    PersistentQueue<int> queue(region, sizeof(region));
+    PersistentBuffer<int> buffer(region, sizeof(region));
+
+    int value = 1;
+    EXPECT_EQ(queue.capacity(), 0);
+    EXPECT_EQ(queue.enqueue(value), OperationResult::Overflow);
+    EXPECT_EQ(queue.dequeue(&value), OperationResult::Empty);
+    EXPECT_EQ(buffer.append(value), OperationResult::Overflow);
+    EXPECT_EQ(buffer.pop(&value), OperationResult::Empty);
+}
+
+TEST(PersistentTest, testMappedFile) {
+    char path[] = "/tmp/collection2_persistent_XXXXXX";
+    int fd = mkstemp(path);
+    ASSERT_GE(fd, 0);
+    close(fd);
+
+    const size_t regionSize = 4096;
+    {
+        MappedFile file;
+        ASSERT_TRUE(file.open(path, regionSize));
+        PersistentQueue<int> queue(file.data(), file.size());
+        EXPECT_FALSE(queue.isRestored());
+        for (int i = 0; i < 100; i++) {
+            queue.enqueue(i);
+        }
+        EXPECT_TRUE(file.flush());
+    }
+
+    // ファイルを開き直しても内容が残っている
+    {
+        MappedFile file;
+        ASSERT_TRUE(file.open(path, regionSize));
+        PersistentQueue<int> queue(file.data(), file.size());
+        EXPECT_TRUE(queue.isRestored());
+        EXPECT_EQ(queue.amount(), 100);
+        for (int i = 0; i < 100; i++) {
+            int value = -1;
+            EXPECT_EQ(queue.dequeue(&value), OperationResult::Success);
+            EXPECT_EQ(value, i);
+        }
+    }
+
+    unlink(path);
+}
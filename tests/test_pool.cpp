@@ -0,0 +1,171 @@
+//
+// オブジェクトプールのテスト
+//
+
+#include <gtest/gtest.h>
+
+#include <type_traits>
+
+#include "collection2/pool.hpp"
+
+using namespace collection2;
+
+TEST(PoolTest, testInstantiate) {
+    // プリミティブ型
+    int intPoolData[8] = {0};
+    Pool<int, unsigned int> intPool(intPoolData, 8);
+
+    // 構造体
+    struct Structure {
+        int integer;
+        char charactor;
+    };
+    Structure structPoolData[8] = {};
+    Pool<Structure, unsigned char> structPool(structPoolData, 8);
+}
+
+TEST(PoolTest, testCapacityAndAmount) {
+    int data[10] = {0};
+    Pool<int, unsigned int> pool(data, 10);
+
+    EXPECT_EQ(pool.capacity(), 10);
+    EXPECT_TRUE(pool.isEmpty());
+
+    pool.acquire(1);
+    pool.acquire(2);
+    pool.acquire(3);
+
+    EXPECT_EQ(pool.amount(), 3);
+    EXPECT_FALSE(pool.isEmpty());
+}
+
+TEST(PoolTest, testAcquireAndRelease) {
+    const int poolLength = 16;
+    int poolData[poolLength] = {0};
+    Pool<int, unsigned int> pool(poolData, poolLength);
+
+    // プールの長さだけ払い出す
+    int* objects[poolLength] = {nullptr};
+    for (int i = 0; i < poolLength; i++) {
+        objects[i] = pool.acquire(i + 1);
+        EXPECT_NE(objects[i], nullptr);
+        EXPECT_EQ(*objects[i], i + 1);
+    }
+
+    // 範囲外の払い出し
+    EXPECT_FALSE(pool.hasSpace());
+    EXPECT_EQ(pool.acquire(), nullptr);
+
+    // 払い出したオブジェクトは重ならない
+    for (int i = 0; i < poolLength; i++) {
+        EXPECT_EQ(*objects[i], i + 1);
+    }
+
+    // 返却したスロットは再利用される
+    EXPECT_EQ(pool.release(objects[3]), OperationResult::Success);
+    EXPECT_EQ(pool.release(objects[7]), OperationResult::Success);
+    EXPECT_EQ(pool.amount(), poolLength - 2);
+    EXPECT_EQ(pool.acquire(100), objects[7]);
+    EXPECT_EQ(pool.acquire(200), objects[3]);
+    EXPECT_EQ(*objects[7], 100);
+    EXPECT_EQ(*objects[3], 200);
+    EXPECT_EQ(pool.acquire(), nullptr);
+}
+
+TEST(PoolTest, testReleaseForeignObject) {
+    int poolData[4] = {0};
+    Pool<int, unsigned int> pool(poolData, 4);
+
+    // 何も払い出していない
+    EXPECT_EQ(pool.release(poolData), OperationResult::Empty);
+
+    // 管理領域外のポインタは受け付けない
+    int foreign = 0;
+    pool.acquire(1);
+    EXPECT_FALSE(pool.owns(&foreign));
+    EXPECT_EQ(pool.release(&foreign), OperationResult::Empty);
+    EXPECT_EQ(pool.release(nullptr), OperationResult::Empty);
+    EXPECT_EQ(pool.amount(), 1);
+}
+
+TEST(PoolTest, testObjectLifetime) {
+    // 構築・破棄の回数を数える
+    struct Counted {
+        static int& alive() {
+            static int value = 0;
+            return value;
+        }
+        long long payload = 0;
+        Counted() { alive()++; }
+        Counted(const Counted& other) : payload(other.payload) { alive()++; }
+        ~Counted() { alive()--; }
+    };
+
+    {
+        Counted poolData[4];
+        EXPECT_EQ(Counted::alive(), 4);
+        {
+            Pool<Counted> pool(poolData, 4);
+
+            // 払い出し時に構築し直すので、生存数は変わらない
+            auto* object = pool.acquire();
+            EXPECT_EQ(Counted::alive(), 4);
+
+            // 返却したオブジェクトは破棄される
+            EXPECT_EQ(pool.release(object), OperationResult::Success);
+            EXPECT_EQ(Counted::alive(), 3);
+
+            // リセットすると返却済みのスロットにオブジェクトが置き直される
+            pool.reset();
+            EXPECT_EQ(Counted::alive(), 4);
+        }
+
+        // プールの破棄は領域内のオブジェクトに影響しない
+        EXPECT_EQ(Counted::alive(), 4);
+    }
+    EXPECT_EQ(Counted::alive(), 0);
+}
+
+TEST(PoolTest, testDestroyLeavesStorage) {
+    unsigned int poolData[4] = {0};
+    {
+        Pool<unsigned int, unsigned int> pool(poolData, 4);
+        *pool.acquire() = 10;
+        *pool.acquire() = 20;
+        pool.release(poolData + 1);
+    }
+
+    // 破棄時に領域を書き換えない
+    EXPECT_EQ(poolData[0], 10);
+    EXPECT_EQ(poolData[1], 4);  // 返却時に書き込まれた空きスロットのリンク
+    EXPECT_EQ(poolData[2], 0);
+    EXPECT_TRUE((std::is_trivially_destructible<Pool<int, unsigned int>>::value));
+}
+
+TEST(PoolTest, testReset) {
+    int poolData[4] = {0};
+    Pool<int, unsigned int> pool(poolData, 4);
+
+    for (int i = 0; i < 4; i++) {
+        pool.acquire(i);
+    }
+    pool.release(poolData + 1);
+
+    // 全て空きに戻る
+    pool.reset();
+    EXPECT_TRUE(pool.isEmpty());
+    for (int i = 0; i < 4; i++) {
+        EXPECT_NE(pool.acquire(i), nullptr);
+    }
+    EXPECT_EQ(pool.acquire(), nullptr);
+}
+
+TEST(PoolTest, testOperateWithZeroSize) {
+    // サイズ0のプール
+    Pool<int, unsigned int> pool(nullptr, 0);
+
+    // 払い出し・返却に失敗する
+    EXPECT_EQ(pool.acquire(), nullptr);
+    int value = 0;
+    EXPECT_EQ(pool.release(&value), OperationResult::Empty);
+}
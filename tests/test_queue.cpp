@@ -3,6 +3,7 @@
 //
 
 #include <gtest/gtest.h>
+#include <stdint.h>
 
 #include "collection2/queue.hpp"
 
@@ -116,3 +117,265 @@ TEST(QueueTest, testOperateWithOneSize) {
     EXPECT_EQ(value, 1);
     EXPECT_EQ(queue.dequeue(&value), OperationResult::Empty);
 }
+
+TEST(QueueTest, testEnqueueAndDequeueN) {
+    int queueData[8] = {0};
+    Queue<int> queue(queueData, 8);
+
+    // 折り返し位置の手前まで進めておく
+    const int prefix[] = {-1, -2, -3, -4, -5, -6};
+    int discarded[6] = {0};
+    EXPECT_EQ(queue.enqueueN(prefix, 6), OperationResult::Success);
+    EXPECT_EQ(queue.dequeueN(discarded, 6), OperationResult::Success);
+    EXPECT_EQ(discarded[5], -6);
+
+    // 折り返しをまたいで追加・取り出しができる
+    const int values[] = {1, 2, 3, 4, 5};
+    EXPECT_EQ(queue.enqueueN(values, 5), OperationResult::Success);
+    EXPECT_EQ(queue.amount(), 5);
+    EXPECT_EQ(queue.enqueueN(values, 4), OperationResult::Overflow);
+    EXPECT_EQ(queue.amount(), 5);
+
+    int value = 0;
+    EXPECT_EQ(queue.dequeue(&value), OperationResult::Success);
+    EXPECT_EQ(value, 1);
+    int received[4] = {0};
+    EXPECT_EQ(queue.dequeueN(received, 5), OperationResult::Empty);
+    EXPECT_EQ(queue.dequeueN(received, 4), OperationResult::Success);
+    for (int i = 0; i < 4; i++) {
+        EXPECT_EQ(received[i], values[i + 1]);
+    }
+    EXPECT_TRUE(queue.isEmpty());
+}
+
+TEST(QueueTest, testConsume) {
+    int queueData[8] = {0};
+    Queue<int> queue(queueData, 8);
+    for (int i = 0; i < 6; i++) {
+        queue.enqueue(i);
+    }
+    int discarded = 0;
+    queue.dequeue(&discarded);
+
+    // 指定した数だけ、先頭から順にコールバックへ渡される
+    int sum = 0;
+    EXPECT_EQ(queue.consume(2, [&sum](int& value) { sum += value; }), 2);
+    EXPECT_EQ(sum, 1 + 2);
+    EXPECT_EQ(queue.amount(), 3);
+
+    // 折り返しをまたいで全て処理する
+    for (int i = 6; i < 10; i++) {
+        queue.enqueue(i);
+    }
+    int expected = 3;
+    bool isOrdered = true;
+    EXPECT_EQ(queue.consumeAll([&](int& value) { isOrdered = isOrdered && value == expected++; }), 7);
+    EXPECT_TRUE(isOrdered);
+    EXPECT_TRUE(queue.isEmpty());
+    EXPECT_EQ(queue.consumeAll([](int&) {}), 0);
+
+    // 処理後も通常どおり追加・取り出しできる
+    int value = 0;
+    queue.enqueue(42);
+    EXPECT_EQ(queue.dequeue(&value), OperationResult::Success);
+    EXPECT_EQ(value, 42);
+}
+
+namespace {
+struct Counted {
+    int value = 0;
+    static int assignments;
+
+    Counted& operator=(const Counted& other) {
+        value = other.value;
+        assignments++;
+        return *this;
+    }
+};
+int Counted::assignments = 0;
+}  // namespace
+
+TEST(QueueTest, testBulkCopyOfNonTrivialType) {
+    static_assert(internal::IsTriviallyCopyable<int>::value, "int must be trivially copyable");
+    static_assert(!internal::IsTriviallyCopyable<Counted>::value, "Counted must not be trivially copyable");
+
+    // トリビアルにコピーできない型は要素ごとに代入される
+    Counted queueData[4];
+    Queue<Counted> queue(queueData, 4);
+    Counted values[3];
+    for (int i = 0; i < 3; i++) {
+        values[i].value = i + 1;
+    }
+    Counted::assignments = 0;
+    EXPECT_EQ(queue.enqueueN(values, 3), OperationResult::Success);
+    EXPECT_EQ(Counted::assignments, 3);
+
+    Counted received[3];
+    EXPECT_EQ(queue.dequeueN(received, 3), OperationResult::Success);
+    EXPECT_EQ(Counted::assignments, 6);
+    EXPECT_EQ(received[2].value, 3);
+}
+
+TEST(QueueTest, testExactCapacity) {
+    // 領域全体が容量として使用される
+    using ExactQueue = Queue<int, size_t, SingleContext, ExactCapacity>;
+    int queueData[10] = {0};
+    ExactQueue queue(queueData, 10);
+    EXPECT_EQ(queue.capacity(), 10);
+
+    for (int i = 0; i < 10; i++) {
+        EXPECT_EQ(queue.enqueue(i), OperationResult::Success);
+    }
+    EXPECT_EQ(queue.enqueue(10), OperationResult::Overflow);
+
+    // 折り返しをまたいで順序が保たれる
+    int value = 0;
+    for (int i = 0; i < 7; i++) {
+        EXPECT_EQ(queue.dequeue(&value), OperationResult::Success);
+        EXPECT_EQ(value, i);
+    }
+    const int appended[] = {10, 11, 12, 13, 14, 15};
+    EXPECT_EQ(queue.enqueueN(appended, 6), OperationResult::Success);
+    EXPECT_EQ(queue.amount(), 9);
+
+    int received[4] = {0};
+    EXPECT_EQ(queue.dequeueN(received, 4), OperationResult::Success);
+    EXPECT_EQ(received[0], 7);
+    EXPECT_EQ(received[3], 10);
+
+    int expected = 11;
+    EXPECT_EQ(queue.consumeAll([&expected](int& element) { EXPECT_EQ(element, expected++); }), 5);
+    EXPECT_TRUE(queue.isEmpty());
+}
+
+TEST(QueueTest, testExactCapacityNearSizeLimit) {
+    // 容量がSizeの最大値に近くても、折り返しの計算が桁あふれしない
+    using ExactQueue = Queue<int, uint8_t, SingleContext, ExactCapacity>;
+    int queueData[255] = {0};
+    ExactQueue queue(queueData, 255);
+    EXPECT_EQ(queue.capacity(), 255);
+
+    for (int round = 0; round < 3; round++) {
+        for (int i = 0; i < 200; i++) {
+            EXPECT_EQ(queue.enqueue(round * 1000 + i), OperationResult::Success);
+        }
+        for (int i = 0; i < 200; i++) {
+            int value = 0;
+            EXPECT_EQ(queue.dequeue(&value), OperationResult::Success);
+            EXPECT_EQ(value, round * 1000 + i);
+        }
+    }
+}
+
+TEST(QueueTest, testExactCapacityFull) {
+    // Sizeの最大値と同じ容量でも、満杯と空を区別できる
+    using ExactQueue = Queue<int, uint8_t, SingleContext, ExactCapacity>;
+    int queueData[255] = {0};
+    ExactQueue queue(queueData, 255);
+
+    for (int round = 0; round < 3; round++) {
+        for (int i = 0; i < 255; i++) {
+            EXPECT_EQ(queue.enqueue(round + i), OperationResult::Success);
+        }
+        EXPECT_EQ(queue.amount(), 255);
+        EXPECT_FALSE(queue.hasSpace());
+        EXPECT_EQ(queue.enqueue(0), OperationResult::Overflow);
+
+        int received[255] = {0};
+        EXPECT_EQ(queue.dequeueN(received, 200), OperationResult::Success);
+        EXPECT_EQ(received[199], round + 199);
+        EXPECT_EQ(queue.consumeAll([](int&) {}), 55);
+        EXPECT_TRUE(queue.isEmpty());
+        EXPECT_EQ(queue.enqueue(0), OperationResult::Success);
+        EXPECT_EQ(queue.dequeue(received), OperationResult::Success);
+    }
+}
+
+TEST(QueueTest, testFreeRunningIndices) {
+    // 1バイトのインデックスが何周しても、データ数が正しく求められる
+    int queueData[8] = {0};
+    Queue<int, uint8_t> queue(queueData, 8);
+    int exactQueueData[10] = {0};
+    Queue<int, uint8_t, SingleContext, ExactCapacity> exactQueue(exactQueueData, 10);
+
+    int next = 0;
+    int expected = 0;
+    for (int round = 0; round < 200; round++) {
+        for (int i = 0; i < 5; i++) {
+            EXPECT_EQ(queue.enqueue(next), OperationResult::Success);
+            EXPECT_EQ(exactQueue.enqueue(next), OperationResult::Success);
+            next++;
+        }
+        EXPECT_EQ(queue.amount(), 5);
+        EXPECT_EQ(exactQueue.amount(), 5);
+
+        // 一括操作とコールバックも折り返しをまたいで動作する
+        int received[3] = {0};
+        EXPECT_EQ(queue.dequeueN(received, 3), OperationResult::Success);
+        EXPECT_EQ(received[0], expected);
+        EXPECT_EQ(received[2], expected + 2);
+        EXPECT_EQ(exactQueue.dequeueN(received, 3), OperationResult::Success);
+        EXPECT_EQ(received[2], expected + 2);
+
+        int consumed = expected + 3;
+        EXPECT_EQ(queue.consumeAll([&consumed](int& value) { EXPECT_EQ(value, consumed++); }), 2);
+        consumed = expected + 3;
+        EXPECT_EQ(exactQueue.consumeAll([&consumed](int& value) { EXPECT_EQ(value, consumed++); }), 2);
+        expected += 5;
+
+        EXPECT_TRUE(queue.isEmpty());
+        EXPECT_TRUE(exactQueue.isEmpty());
+    }
+
+    // 満杯の判定もインデックスの差から行われる
+    for (int i = 0; i < 8; i++) {
+        EXPECT_EQ(queue.enqueue(i), OperationResult::Success);
+    }
+    EXPECT_FALSE(queue.hasSpace());
+    EXPECT_EQ(queue.enqueue(8), OperationResult::Overflow);
+}
+
+namespace {
+int constantQueueData[10];
+constexpr Queue<int> constantQueue(constantQueueData, 10);
+}  // namespace
+
+TEST(QueueTest, testConstantInitialization) {
+    // 容量の計算はコンパイル時に行われる
+    static_assert(constantQueue.capacity() == 8, "capacity must be computed at compile time");
+    static_assert(constantQueue.isEmpty(), "queue must be empty at compile time");
+    EXPECT_EQ(constantQueue.amount(), 0);
+}
+
+namespace {
+constexpr Queue<int, size_t, SingleContext, ExactCapacity> constantExactQueue(constantQueueData, 10);
+}  // namespace
+
+TEST(QueueTest, testConstantInitializationWithExactCapacity) {
+    static_assert(constantExactQueue.capacity() == 10, "capacity must be computed at compile time");
+    EXPECT_TRUE(constantExactQueue.isEmpty());
+}
+
+#if __cplusplus >= 201402L
+namespace {
+struct PrebuiltQueue {
+    int data[4];
+    Queue<int> queue;
+
+    constexpr PrebuiltQueue() : data{}, queue(data, 4) {
+        queue.enqueue(1);
+        queue.enqueue(2);
+        queue.enqueue(3);
+        int value = 0;
+        queue.dequeue(&value);
+    }
+};
+constexpr PrebuiltQueue prebuiltQueue;
+}  // namespace
+
+TEST(QueueTest, testConstantEvaluation) {
+    // C++14以降では、追加・取り出しも定数式で評価できる
+    static_assert(prebuiltQueue.queue.amount() == 2, "enqueue/dequeue must be evaluated at compile time");
+    static_assert(prebuiltQueue.data[2] == 3, "enqueued data must be placed at compile time");
+}
+#endif
@@ -0,0 +1,91 @@
+//
+// 基数木のテスト
+//
+
+#include <gtest/gtest.h>
+
+#include "collection2/radix_trie.hpp"
+
+using namespace collection2;
+
+TEST(RadixTrieTest, testInsertAndFind) {
+    RadixTrieNode<int> nodes[16];
+    RadixTrie<int> trie(nodes, 16);
+
+    EXPECT_EQ(trie.insert("romane", 1), OperationResult::Success);
+    EXPECT_EQ(trie.insert("romanus", 2), OperationResult::Success);
+    EXPECT_EQ(trie.insert("romulus", 3), OperationResult::Success);
+    EXPECT_EQ(trie.insert("rubens", 4), OperationResult::Success);
+    EXPECT_EQ(trie.insert("ruber", 5), OperationResult::Success);
+    EXPECT_EQ(trie.insert("rom", 6), OperationResult::Success);
+    EXPECT_EQ(trie.amount(), 6);
+
+    EXPECT_EQ(*trie.find("romane"), 1);
+    EXPECT_EQ(*trie.find("romanus"), 2);
+    EXPECT_EQ(*trie.find("romulus"), 3);
+    EXPECT_EQ(*trie.find("rubens"), 4);
+    EXPECT_EQ(*trie.find("ruber"), 5);
+    EXPECT_EQ(*trie.find("rom"), 6);
+
+    // 途中までしか一致しないキーや、分岐点だけのキーは見つからない
+    EXPECT_EQ(trie.find("roman"), nullptr);
+    EXPECT_EQ(trie.find("r"), nullptr);
+    EXPECT_EQ(trie.find("romanes"), nullptr);
+    EXPECT_EQ(trie.find(""), nullptr);
+
+    // 同じキーは上書き
+    EXPECT_EQ(trie.insert("ruber", 50), OperationResult::Success);
+    EXPECT_EQ(*trie.find("ruber"), 50);
+    EXPECT_EQ(trie.amount(), 6);
+}
+
+TEST(RadixTrieTest, testLongestPrefix) {
+    RadixTrieNode<int> nodes[16];
+    RadixTrie<int> trie(nodes, 16);
+
+    trie.insert("sensor/", 1);
+    trie.insert("sensor/temp", 2);
+    trie.insert("sensor/temperature/max", 3);
+    trie.insert("led", 4);
+
+    size_t matched = 0;
+    EXPECT_EQ(*trie.longestPrefix("sensor/temperature", &matched), 2);
+    EXPECT_EQ(matched, 11);
+    EXPECT_EQ(*trie.longestPrefix("sensor/temperature/max/1", &matched), 3);
+    EXPECT_EQ(matched, 22);
+    EXPECT_EQ(*trie.longestPrefix("sensor/humidity", &matched), 1);
+    EXPECT_EQ(matched, 7);
+    EXPECT_EQ(trie.longestPrefix("sense"), nullptr);
+
+    // 長さを指定すれば、NUL終端されていない受信データも扱える
+    const char received[] = {'l', 'e', 'd', '=', '1'};
+    EXPECT_EQ(*trie.longestPrefix(received, sizeof(received), &matched), 4);
+    EXPECT_EQ(matched, 3);
+
+    // 空のキーは全ての文字列の接頭辞になる
+    trie.insert("", 0);
+    EXPECT_EQ(*trie.longestPrefix("unknown"), 0);
+}
+
+TEST(RadixTrieTest, testOverflow) {
+    RadixTrieNode<int> nodes[2];
+    RadixTrie<int> trie(nodes, 2);
+
+    EXPECT_EQ(trie.insert("abc", 1), OperationResult::Success);
+
+    // 分割と葉の追加で2つ必要なところ、残りは1つしかない
+    EXPECT_EQ(trie.insert("abd", 2), OperationResult::Overflow);
+    EXPECT_EQ(*trie.find("abc"), 1);
+    EXPECT_EQ(trie.amount(), 1);
+
+    // 分割だけなら1つで足りる
+    EXPECT_EQ(trie.insert("ab", 3), OperationResult::Success);
+    EXPECT_EQ(*trie.find("ab"), 3);
+    EXPECT_EQ(*trie.find("abc"), 1);
+
+    // 全て削除すると再び使える
+    trie.clear();
+    EXPECT_TRUE(trie.isEmpty());
+    EXPECT_EQ(trie.find("abc"), nullptr);
+    EXPECT_EQ(trie.insert("xyz", 4), OperationResult::Success);
+}
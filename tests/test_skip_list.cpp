@@ -0,0 +1,152 @@
+//
+// スキップリストのテスト
+//
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "collection2/skip_list.hpp"
+
+using namespace collection2;
+
+TEST(SkipListTest, testInsertAndIterate) {
+    SkipListNode<int> nodes[8];
+    SkipListIndex<int> indices[8];
+    SkipList<int> list(nodes, 8, indices, 8);
+    EXPECT_TRUE(list.isEmpty());
+    EXPECT_EQ(list.head(), nullptr);
+
+    const int values[] = {5, 1, 4, 1, 3, 9, 2, 6};
+    for (int value : values) {
+        EXPECT_EQ(list.insert(value), OperationResult::Success);
+    }
+    EXPECT_EQ(list.insert(0), OperationResult::Overflow);
+    EXPECT_EQ(list.amount(), 8);
+
+    // 先頭からたどると昇順に並んでいる
+    const int expected[] = {1, 1, 2, 3, 4, 5, 6, 9};
+    int index = 0;
+    for (auto* node = list.head(); node != nullptr; node = node->next) {
+        EXPECT_EQ(node->element, expected[index++]);
+    }
+    EXPECT_EQ(index, 8);
+}
+
+TEST(SkipListTest, testFindAndLowerBound) {
+    SkipListNode<int> nodes[32];
+    SkipListIndex<int> indices[32];
+    SkipList<int> list(nodes, 32, indices, 32);
+    for (int i = 0; i < 32; i++) {
+        list.insert(i * 10);
+    }
+
+    EXPECT_EQ(*list.find(120), 120);
+    EXPECT_EQ(list.find(125), nullptr);
+    EXPECT_EQ(list.find(-1), nullptr);
+    EXPECT_EQ(list.lowerBound(125)->element, 130);
+    EXPECT_EQ(list.lowerBound(-5), list.head());
+    EXPECT_EQ(list.lowerBound(311), nullptr);
+}
+
+TEST(SkipListTest, testRandomOperationsMatchSortedReference) {
+    const int length = 256;
+    SkipListNode<int, uint16_t> nodes[length];
+    SkipListIndex<int, uint16_t> indices[length];
+    SkipList<int, uint16_t, 8> list(nodes, length, indices, length);
+    std::vector<int> reference;
+
+    // 挿入・削除・先頭の取り出しを混ぜて行い、ソート済みの配列と比較する
+    uint32_t seed = 7;
+    for (int step = 0; step < 5000; step++) {
+        seed = seed * 1103515245 + 12345;
+        const int value = static_cast<int>((seed >> 16) % 100);
+        const int operation = static_cast<int>((seed >> 8) % 4);
+        if (operation < 2) {
+            const auto result = list.insert(value);
+            if (reference.size() < length) {
+                ASSERT_EQ(result, OperationResult::Success);
+                reference.insert(std::upper_bound(reference.begin(), reference.end(), value), value);
+            } else {
+                ASSERT_EQ(result, OperationResult::Overflow);
+            }
+        } else if (operation == 2) {
+            const auto position = std::lower_bound(reference.begin(), reference.end(), value);
+            const bool exists = position != reference.end() && *position == value;
+            ASSERT_EQ(list.remove(value), exists ? OperationResult::Success : OperationResult::Empty);
+            if (exists) {
+                reference.erase(position);
+            }
+        } else {
+            int popped = -1;
+            if (reference.empty()) {
+                ASSERT_EQ(list.pop(&popped), OperationResult::Empty);
+            } else {
+                ASSERT_EQ(list.pop(&popped), OperationResult::Success);
+                ASSERT_EQ(popped, reference.front());
+                reference.erase(reference.begin());
+            }
+        }
+
+        ASSERT_EQ(list.amount(), reference.size());
+        size_t index = 0;
+        for (auto* node = list.head(); node != nullptr; node = node->next) {
+            ASSERT_LT(index, reference.size());
+            ASSERT_EQ(node->element, reference[index++]);
+        }
+        ASSERT_EQ(index, reference.size());
+    }
+}
+
+namespace {
+struct Timer {
+    uint32_t deadline;
+    int id;
+
+    bool operator<(const Timer& other) const {
+        return deadline < other.deadline;
+    }
+};
+}  // namespace
+
+TEST(SkipListTest, testStableOrderWithoutIndices) {
+    // 索引の領域がなくても、最下段のリストだけで動作する
+    SkipListNode<Timer> nodes[8];
+    SkipList<Timer> timers(nodes, 8, nullptr, 0);
+
+    timers.insert({30, 1});
+    timers.insert({10, 2});
+    timers.insert({30, 3});
+    timers.insert({20, 4});
+
+    // 等しい要素は挿入した順に取り出される
+    const int expected[] = {2, 4, 1, 3};
+    for (int id : expected) {
+        Timer timer = {0, 0};
+        EXPECT_EQ(timers.pop(&timer), OperationResult::Success);
+        EXPECT_EQ(timer.id, id);
+    }
+    EXPECT_EQ(timers.pop(nullptr), OperationResult::Empty);
+}
+
+TEST(SkipListTest, testClear) {
+    SkipListNode<int> nodes[16];
+    SkipListIndex<int> indices[16];
+    SkipList<int> list(nodes, 16, indices, 16);
+    for (int i = 0; i < 16; i++) {
+        list.insert(i);
+    }
+
+    list.clear();
+    EXPECT_TRUE(list.isEmpty());
+    EXPECT_EQ(list.head(), nullptr);
+    EXPECT_EQ(list.find(3), nullptr);
+
+    // 全ての領域を再び使える
+    for (int i = 16; i > 0; i--) {
+        EXPECT_EQ(list.insert(i), OperationResult::Success);
+    }
+    EXPECT_EQ(list.head()->element, 1);
+}
@@ -0,0 +1,87 @@
+//
+// スライディングウィンドウのテスト
+//
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+
+#include "collection2/sliding_window.hpp"
+
+using namespace collection2;
+
+TEST(SlidingWindowTest, testEmptyWindow) {
+    SlidingWindowSlot<int> slots[4];
+    SlidingWindow<int> window(slots, 4);
+
+    EXPECT_TRUE(window.isEmpty());
+    EXPECT_EQ(window.minimum(), nullptr);
+    EXPECT_EQ(window.maximum(), nullptr);
+    EXPECT_EQ(window.sum(), 0);
+    EXPECT_EQ(window.mean(), 0);
+    EXPECT_EQ(window.pop(nullptr), OperationResult::Empty);
+
+    // サイズ0のウィンドウには追加できない
+    SlidingWindow<int> zeroWindow(nullptr, 0);
+    EXPECT_EQ(zeroWindow.append(1), OperationResult::Overflow);
+}
+
+TEST(SlidingWindowTest, testAggregatesMatchRecomputation) {
+    const int windowLength = 8;
+    SlidingWindowSlot<int16_t, uint8_t> slots[windowLength];
+    SlidingWindow<int16_t, uint8_t, int32_t> window(slots, windowLength);
+
+    // 通し番号が一周する程度まで追加し、毎回全体を計算し直した値と比較する
+    int16_t history[600];
+    uint32_t seed = 1;
+    for (int i = 0; i < 600; i++) {
+        seed = seed * 1103515245 + 12345;
+        history[i] = static_cast<int16_t>((seed >> 16) % 2001) - 1000;
+        EXPECT_EQ(window.append(history[i]), OperationResult::Success);
+
+        const int first = i + 1 < windowLength ? 0 : i + 1 - windowLength;
+        int16_t expectedMin = history[first];
+        int16_t expectedMax = history[first];
+        int32_t expectedSum = 0;
+        for (int j = first; j <= i; j++) {
+            expectedMin = history[j] < expectedMin ? history[j] : expectedMin;
+            expectedMax = history[j] > expectedMax ? history[j] : expectedMax;
+            expectedSum += history[j];
+        }
+        ASSERT_EQ(window.amount(), i + 1 - first);
+        ASSERT_EQ(*window.minimum(), expectedMin);
+        ASSERT_EQ(*window.maximum(), expectedMax);
+        ASSERT_EQ(window.sum(), expectedSum);
+        ASSERT_EQ(window.mean(), expectedSum / (i + 1 - first));
+    }
+}
+
+TEST(SlidingWindowTest, testPopAndClear) {
+    SlidingWindowSlot<double> slots[4];
+    SlidingWindow<double> window(slots, 4);
+
+    window.append(3.0);
+    window.append(1.0);
+    window.append(2.0);
+    EXPECT_EQ(*window.minimum(), 1.0);
+    EXPECT_EQ(*window.maximum(), 3.0);
+
+    // 最も古い要素を取り出すと、集計値からも外れる
+    double value = 0;
+    EXPECT_EQ(window.pop(&value), OperationResult::Success);
+    EXPECT_EQ(value, 3.0);
+    EXPECT_EQ(*window.maximum(), 2.0);
+    EXPECT_DOUBLE_EQ(window.mean(), 1.5);
+
+    // 同じ値が並んでも正しく外れる
+    window.append(1.0);
+    EXPECT_EQ(window.pop(nullptr), OperationResult::Success);
+    EXPECT_EQ(*window.minimum(), 1.0);
+    EXPECT_EQ(window.amount(), 2);
+
+    window.clear();
+    EXPECT_TRUE(window.isEmpty());
+    EXPECT_EQ(window.sum(), 0.0);
+    window.append(5.0);
+    EXPECT_EQ(*window.minimum(), 5.0);
+    EXPECT_EQ(*window.maximum(), 5.0);
+}
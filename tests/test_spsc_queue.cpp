@@ -0,0 +1,142 @@
+//
+// 単一生産者・単一消費者キューのテスト
+//
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+
+#include <thread>
+
+#include "collection2/spsc_queue.hpp"
+
+using namespace collection2;
+
+TEST(SpscQueueTest, testLayout) {
+    int data[8] = {0};
+    SpscQueue<int> queue(data, 8);
+
+    // 生産者側と消費者側は別のキャッシュラインに置かれる
+    EXPECT_GE(sizeof(queue), COLLECTION2_CACHE_LINE_SIZE * 2);
+    EXPECT_EQ(alignof(SpscQueue<int>) % COLLECTION2_CACHE_LINE_SIZE, 0);
+}
+
+TEST(SpscQueueTest, testCapacityAndAmount) {
+    int data[10] = {0};
+    SpscQueue<int> queue(data, 10);
+
+    EXPECT_EQ(queue.capacity(), 8);
+
+    queue.enqueue(1);
+    queue.enqueue(2);
+    queue.enqueue(3);
+
+    EXPECT_EQ(queue.amount(), 3);
+}
+
+TEST(SpscQueueTest, testOperate) {
+    const int queueLength = 16;
+    int queueData[queueLength] = {0};
+    SpscQueue<int, uint8_t> queue(queueData, queueLength);
+
+    // インデックスが何周しても正しく動作する
+    for (int round = 0; round < 40; round++) {
+        for (int i = 0; i < queueLength; i++) {
+            EXPECT_EQ(queue.enqueue(round + i), OperationResult::Success);
+        }
+        EXPECT_EQ(queue.enqueue(0), OperationResult::Overflow);
+
+        for (int i = 0; i < queueLength; i++) {
+            int value = 0;
+            EXPECT_EQ(queue.dequeue(&value), OperationResult::Success);
+            EXPECT_EQ(value, round + i);
+        }
+        int dummy = 0;
+        EXPECT_EQ(queue.dequeue(&dummy), OperationResult::Empty);
+    }
+}
+
+TEST(SpscQueueTest, testOperateWithZeroSize) {
+    SpscQueue<int> queue(nullptr, 0);
+
+    int value = 1;
+    EXPECT_EQ(queue.enqueue(value), OperationResult::Overflow);
+    EXPECT_EQ(queue.dequeue(&value), OperationResult::Empty);
+}
+
+TEST(SpscQueueTest, testConsume) {
+    int queueData[8] = {0};
+    SpscQueue<int, uint8_t> queue(queueData, 8);
+
+    // インデックスが何周しても、先頭から順にまとめて処理できる
+    int expected = 0;
+    bool isOrdered = true;
+    for (int round = 0; round < 100; round++) {
+        for (int i = 0; i < 5; i++) {
+            queue.enqueue(round * 5 + i);
+        }
+        EXPECT_EQ(queue.consume(3, [&](int& value) { isOrdered = isOrdered && value == expected++; }), 3);
+        EXPECT_EQ(queue.consumeAll([&](int& value) { isOrdered = isOrdered && value == expected++; }), 2);
+    }
+    EXPECT_TRUE(isOrdered);
+    EXPECT_TRUE(queue.isEmpty());
+}
+
+TEST(SpscQueueTest, testConcurrentConsume) {
+    const int queueLength = 64;
+    const int transferCount = 200000;
+    int queueData[queueLength] = {0};
+    SpscQueue<int> queue(queueData, queueLength);
+
+    std::thread producer([&queue]() {
+        for (int i = 0; i < transferCount; i++) {
+            while (queue.enqueue(i) != OperationResult::Success) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    // 消費者側は届いている分をまとめて処理する
+    int expected = 0;
+    bool isOrdered = true;
+    while (expected < transferCount) {
+        if (queue.consumeAll([&](int& value) { isOrdered = isOrdered && value == expected++; }) == 0) {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    EXPECT_TRUE(isOrdered);
+    EXPECT_TRUE(queue.isEmpty());
+}
+
+TEST(SpscQueueTest, testConcurrentTransfer) {
+    const int queueLength = 64;
+    const int transferCount = 200000;
+    int queueData[queueLength] = {0};
+    SpscQueue<int> queue(queueData, queueLength);
+
+    // 生産者スレッドが連番を送り、消費者側で順序と欠落を確認する
+    std::thread producer([&queue]() {
+        for (int i = 0; i < transferCount; i++) {
+            while (queue.enqueue(i) != OperationResult::Success) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    int expected = 0;
+    bool isOrdered = true;
+    while (expected < transferCount) {
+        int value = 0;
+        if (queue.dequeue(&value) != OperationResult::Success) {
+            std::this_thread::yield();
+            continue;
+        }
+        isOrdered = isOrdered && (value == expected);
+        expected++;
+    }
+    producer.join();
+
+    EXPECT_TRUE(isOrdered);
+    EXPECT_TRUE(queue.isEmpty());
+}
@@ -90,3 +90,129 @@ TEST(StackTest, testOperateWithOneSize) {
     EXPECT_EQ(value, 1);
     EXPECT_EQ(Stack.pop(&value), OperationResult::Empty);
 }
+
+TEST(StackTest, testBulkOperation) {
+    const int stackLength = 10;
+    int stackData[stackLength] = {0};
+    Stack<int> stack(stackData, stackLength);
+
+    // まとめて追加
+    int source[] = {1, 2, 3, 4, 5, 6};
+    EXPECT_EQ(stack.pushN(source, 6), OperationResult::Success);
+    EXPECT_EQ(stack.amount(), 6);
+
+    // 入りきらない場合は何も追加しない
+    EXPECT_EQ(stack.pushN(source, 5), OperationResult::Overflow);
+    EXPECT_EQ(stack.amount(), 6);
+
+    // 最後に追加したものが先頭
+    int value = 0;
+    EXPECT_EQ(stack.pop(&value), OperationResult::Success);
+    EXPECT_EQ(value, 6);
+
+    // 積まれていた順に取り出される
+    int destination[3] = {0};
+    EXPECT_EQ(stack.popN(destination, 3), OperationResult::Success);
+    EXPECT_EQ(destination[0], 3);
+    EXPECT_EQ(destination[1], 4);
+    EXPECT_EQ(destination[2], 5);
+
+    // 足りない場合は何も取り出さない
+    EXPECT_EQ(stack.popN(destination, 3), OperationResult::Empty);
+    EXPECT_EQ(stack.amount(), 2);
+    EXPECT_EQ(stack.popN(destination, 0), OperationResult::Success);
+}
+
+TEST(StackTest, testTop) {
+    int stackData[4] = {0};
+    Stack<int> stack(stackData, 4);
+
+    EXPECT_EQ(stack.top(), nullptr);
+
+    stack.push(1);
+    stack.push(2);
+    EXPECT_EQ(*stack.top(), 2);
+
+    // 参照先を書き換えられる
+    *stack.top() = 3;
+    int value = 0;
+    stack.pop(&value);
+    EXPECT_EQ(value, 3);
+    EXPECT_EQ(*stack.top(), 1);
+}
+
+TEST(StackTest, testDualStack) {
+    const int stackLength = 8;
+    int stackData[stackLength] = {0};
+    DualStack<int> stack(stackData, stackLength);
+
+    EXPECT_EQ(stack.capacity(), stackLength);
+    EXPECT_TRUE(stack.isEmpty(DualStackSide::Lower));
+    EXPECT_TRUE(stack.isEmpty(DualStackSide::Upper));
+
+    // 境界は固定されず、合計で領域長まで追加できる
+    for (int i = 0; i < 5; i++) {
+        EXPECT_EQ(stack.push(DualStackSide::Lower, i + 1), OperationResult::Success);
+    }
+    for (int i = 0; i < 3; i++) {
+        EXPECT_EQ(stack.push(DualStackSide::Upper, (i + 1) * 10), OperationResult::Success);
+    }
+    EXPECT_FALSE(stack.hasSpace());
+    EXPECT_EQ(stack.push(DualStackSide::Lower, 0), OperationResult::Overflow);
+    EXPECT_EQ(stack.push(DualStackSide::Upper, 0), OperationResult::Overflow);
+    EXPECT_EQ(stack.amount(DualStackSide::Lower), 5);
+    EXPECT_EQ(stack.amount(DualStackSide::Upper), 3);
+    EXPECT_EQ(*stack.top(DualStackSide::Lower), 5);
+    EXPECT_EQ(*stack.top(DualStackSide::Upper), 30);
+
+    // それぞれ後入れ先出しで取り出せる
+    int value = 0;
+    for (int i = 3; i > 0; i--) {
+        EXPECT_EQ(stack.pop(DualStackSide::Upper, &value), OperationResult::Success);
+        EXPECT_EQ(value, i * 10);
+    }
+    EXPECT_EQ(stack.pop(DualStackSide::Upper, &value), OperationResult::Empty);
+    for (int i = 5; i > 0; i--) {
+        EXPECT_EQ(stack.pop(DualStackSide::Lower, &value), OperationResult::Success);
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_EQ(stack.pop(DualStackSide::Lower, &value), OperationResult::Empty);
+}
+
+TEST(StackTest, testDualStackBulkOperation) {
+    const int stackLength = 8;
+    int stackData[stackLength] = {0};
+    DualStack<int> stack(stackData, stackLength);
+
+    int source[] = {1, 2, 3, 4, 5};
+    EXPECT_EQ(stack.pushN(DualStackSide::Upper, source, 5), OperationResult::Success);
+    EXPECT_EQ(stack.pushN(DualStackSide::Lower, source, 4), OperationResult::Overflow);
+    EXPECT_EQ(stack.pushN(DualStackSide::Lower, source, 3), OperationResult::Success);
+
+    // 上側も push を繰り返したのと同じ順序になる
+    int value = 0;
+    EXPECT_EQ(stack.pop(DualStackSide::Upper, &value), OperationResult::Success);
+    EXPECT_EQ(value, 5);
+
+    int destination[4] = {0};
+    EXPECT_EQ(stack.popN(DualStackSide::Upper, destination, 4), OperationResult::Success);
+    for (int i = 0; i < 4; i++) {
+        EXPECT_EQ(destination[i], i + 1);
+    }
+    EXPECT_EQ(stack.popN(DualStackSide::Lower, destination, 4), OperationResult::Empty);
+    EXPECT_EQ(stack.popN(DualStackSide::Lower, destination, 3), OperationResult::Success);
+    for (int i = 0; i < 3; i++) {
+        EXPECT_EQ(destination[i], i + 1);
+    }
+}
+
+TEST(StackTest, testDualStackWithZeroSize) {
+    // サイズ0の両端スタック
+    DualStack<int> stack(nullptr, 0);
+
+    int value = 1;
+    EXPECT_EQ(stack.push(DualStackSide::Lower, value), OperationResult::Overflow);
+    EXPECT_EQ(stack.push(DualStackSide::Upper, value), OperationResult::Overflow);
+    EXPECT_EQ(stack.pop(DualStackSide::Lower, &value), OperationResult::Empty);
+    EXPECT_EQ(stack.pop(DualStackSide::Upper, &value), OperationResult::Empty);
+}
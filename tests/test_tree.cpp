@@ -3,6 +3,11 @@
 //
 
 #include <gtest/gtest.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <type_traits>
+#include <vector>
 
 #include "collection2/tree.hpp"
 
@@ -79,3 +84,408 @@ TEST(TreeTest, testRemove) {
     EXPECT_EQ(rootNode->rhs->lhs, nullptr);
     EXPECT_EQ(rootNode->rhs->rhs, nullptr);
 }
+
+// 二分探索木に値を挿入する (テスト用)
+static void insertToSearchTree(Tree<int>& tree, TreeNode<int>* root, int value) {
+    auto* node = root;
+    while (true) {
+        const auto side = value < node->element ? TreeNodeSide::Left : TreeNodeSide::Right;
+        auto* child = side == TreeNodeSide::Left ? node->lhs : node->rhs;
+        if (child == nullptr) {
+            tree.appendChild(node, value, side);
+            return;
+        }
+        node = child;
+    }
+}
+
+TEST(TreeTest, testFreeze) {
+    const int nodeCount = 100;
+    TreeNode<int> nodePool[nodeCount];
+    Tree<int> tree(nodePool, nodeCount);
+
+    // 偶数 0, 2, ..., 198 を適当な順番で挿入した二分探索木
+    auto* rootNode = tree.retainNode(100);
+    for (int i = 1; i < nodeCount; i++) {
+        insertToSearchTree(tree, rootNode, ((i * 37 + 50) % nodeCount) * 2);
+    }
+
+    // 容量が足りなければ書き出せない
+    int smallData[nodeCount - 1];
+    FrozenTree<int> small(smallData, nodeCount - 1);
+    EXPECT_EQ(tree.freeze(rootNode, small), OperationResult::Overflow);
+    EXPECT_TRUE(small.isEmpty());
+
+    int frozenData[nodeCount];
+    FrozenTree<int> frozen(frozenData, nodeCount);
+    EXPECT_EQ(tree.freeze(rootNode, frozen), OperationResult::Success);
+    EXPECT_EQ(frozen.amount(), nodeCount);
+
+    // 幅優先順に並んでいる: 先頭は中央値、子は2k, 2k+1番目
+    for (int i = 1; i <= nodeCount; i++) {
+        if (i * 2 <= nodeCount) {
+            EXPECT_LT(frozenData[i * 2 - 1], frozenData[i - 1]);
+        }
+        if (i * 2 + 1 <= nodeCount) {
+            EXPECT_GT(frozenData[i * 2], frozenData[i - 1]);
+        }
+    }
+
+    // 全ての値が見つかり、それ以外は見つからない
+    for (int i = 0; i < nodeCount; i++) {
+        const auto* found = frozen.find(i * 2);
+        ASSERT_NE(found, nullptr);
+        EXPECT_EQ(*found, i * 2);
+        EXPECT_EQ(frozen.find(i * 2 + 1), nullptr);
+        if (i < nodeCount - 1) {
+            EXPECT_EQ(*frozen.lowerBound(i * 2 + 1), i * 2 + 2);
+        }
+    }
+    EXPECT_EQ(*frozen.lowerBound(-100), 0);
+    EXPECT_EQ(frozen.lowerBound(nodeCount * 2), nullptr);
+}
+
+TEST(TreeTest, testFreezeDegenerateTree) {
+    TreeNode<int> nodePool[16];
+    Tree<int> tree(nodePool, 16);
+
+    // 右にだけ伸びた木も完全二分木として書き出される
+    auto* rootNode = tree.retainNode(0);
+    auto* node = rootNode;
+    for (int i = 1; i < 10; i++) {
+        tree.appendChild(node, i * 10, TreeNodeSide::Right, &node);
+    }
+
+    int frozenData[16];
+    FrozenTree<int> frozen(frozenData, 16);
+    EXPECT_EQ(tree.freeze(rootNode, frozen), OperationResult::Success);
+    EXPECT_EQ(frozen.amount(), 10);
+    for (int i = 0; i < 10; i++) {
+        EXPECT_NE(frozen.find(i * 10), nullptr);
+    }
+    EXPECT_EQ(frozen.find(5), nullptr);
+
+    // 空の木
+    EXPECT_EQ(tree.freeze(nullptr, frozen), OperationResult::Empty);
+    EXPECT_EQ(frozen.find(0), nullptr);
+}
+
+namespace {
+using RouteNode = TreeNode<int>;
+
+// 構築済みのツリーを静的に配置する
+RouteNode routeNodes[8] = {
+    RouteNode(50, &routeNodes[1], &routeNodes[2]),
+    RouteNode(25, &routeNodes[3]),
+    RouteNode(75),
+    RouteNode(10),
+};
+Tree<int> routeTree(routeNodes, 8, 4);
+}  // namespace
+
+TEST(TreeTest, testPrebuiltTree) {
+    // デストラクタを持たないので、静的なツリーの破棄処理は登録されない
+    EXPECT_TRUE((std::is_trivially_destructible<Tree<int>>::value));
+
+    // 構築済みのノードは払い出し済みとして扱われる
+    EXPECT_EQ(routeTree.amount(), 4);
+    EXPECT_EQ(routeNodes[0].lhs->element, 25);
+    EXPECT_EQ(routeNodes[0].rhs->element, 75);
+    EXPECT_EQ(routeNodes[1].lhs->element, 10);
+    EXPECT_TRUE(routeNodes[2].isLeaf());
+
+    // 以降のノードは残りの領域から確保される
+    RouteNode* added = nullptr;
+    EXPECT_EQ(routeTree.appendChild(&routeNodes[2], 90, TreeNodeSide::Right, &added), OperationResult::Success);
+    EXPECT_EQ(added, &routeNodes[4]);
+
+    // 構築済みのノードも返却・再利用できる
+    routeNodes[1].lhs = nullptr;
+    routeTree.removeChild(&routeNodes[3]);
+    EXPECT_EQ(routeTree.amount(), 4);
+    EXPECT_EQ(routeTree.retainNode(), &routeNodes[3]);
+}
+
+TEST(TreeTest, testRotate) {
+    using Node = TreeNode<int, size_t, true>;
+    Node nodePool[8];
+    Tree<int, size_t, true> tree(nodePool, 8);
+
+    /// 10 - 20 - 30 と右に連なった木を、20を根とする木に回転する
+    auto* root = tree.retainNode(0);
+    Node* a = nullptr;
+    Node* b = nullptr;
+    Node* c = nullptr;
+    tree.appendChild(root, 10, TreeNodeSide::Right, &a);
+    tree.appendChild(a, 20, TreeNodeSide::Right, &b);
+    tree.appendChild(b, 30, TreeNodeSide::Right, &c);
+    tree.appendChild(b, 15, TreeNodeSide::Left);
+    EXPECT_EQ(b->parent, a);
+
+    EXPECT_EQ(tree.rotateLeft(a), b);
+    EXPECT_EQ(root->rhs, b);
+    EXPECT_EQ(b->parent, root);
+    EXPECT_EQ(b->lhs, a);
+    EXPECT_EQ(a->parent, b);
+    EXPECT_EQ(a->rhs->element, 15);
+    EXPECT_EQ(a->rhs->parent, a);
+
+    // 右回転で元に戻る
+    EXPECT_EQ(tree.rotateRight(b), a);
+    EXPECT_EQ(root->rhs, a);
+    EXPECT_EQ(a->rhs, b);
+    EXPECT_EQ(b->lhs->element, 15);
+    EXPECT_EQ(b->lhs->parent, b);
+
+    // 回転できない向き
+    EXPECT_EQ(tree.rotateRight(c), nullptr);
+}
+
+TEST(TreeTest, testRotateWithoutParentLink) {
+    TreeNode<int> nodePool[4];
+    Tree<int> tree(nodePool, 4);
+
+    // 親リンクを持たない場合、返された根を呼び出し側で繋ぎ直す
+    auto* root = tree.retainNode(0);
+    TreeNode<int>* a = nullptr;
+    tree.appendChild(root, 10, TreeNodeSide::Left, &a);
+    tree.appendChild(a, 5, TreeNodeSide::Left);
+    root->lhs = tree.rotateRight(a);
+    EXPECT_EQ(root->lhs->element, 5);
+    EXPECT_EQ(root->lhs->rhs, a);
+    EXPECT_TRUE(a->isLeaf());
+    EXPECT_EQ(sizeof(TreeNode<int>), sizeof(TreeNode<int, size_t, true>) - sizeof(void*));
+}
+
+TEST(TreeTest, testReplaceAndDetach) {
+    using Node = TreeNode<int, size_t, true>;
+    Node nodePool[8];
+    Tree<int, size_t, true> tree(nodePool, 8);
+
+    auto* root = tree.retainNode(0);
+    Node* a = nullptr;
+    Node* b = nullptr;
+    tree.appendChild(root, 10, TreeNodeSide::Left, &a);
+    tree.appendChild(a, 20, TreeNodeSide::Right, &b);
+
+    // 子で親を置き換える
+    EXPECT_EQ(tree.replaceSubtree(a, b), OperationResult::Success);
+    EXPECT_EQ(root->lhs, b);
+    EXPECT_EQ(b->parent, root);
+    EXPECT_EQ(a->parent, nullptr);
+    EXPECT_EQ(a->rhs, nullptr);
+
+    // 切り離した部分木を別の場所に繋ぎ直す
+    EXPECT_EQ(tree.detach(b), OperationResult::Success);
+    EXPECT_EQ(root->lhs, nullptr);
+    EXPECT_EQ(b->parent, nullptr);
+    EXPECT_EQ(tree.linkNode(*root, b, TreeNodeSide::Right), OperationResult::Success);
+    EXPECT_EQ(b->parent, root);
+
+    // リーフを削除すると親から外れる
+    tree.removeChild(b);
+    EXPECT_EQ(root->rhs, nullptr);
+    EXPECT_EQ(tree.detach(nullptr), OperationResult::Empty);
+}
+
+TEST(TreeTest, testSharedPool) {
+    TreeNode<int> nodes[4];
+    Pool<TreeNode<int>> pool(nodes, 4);
+    Tree<int, size_t, false, NoAugmentation, SharedPool> first(pool);
+    Tree<int, size_t, false, NoAugmentation, SharedPool> second(pool);
+    EXPECT_EQ(sizeof(first), sizeof(void*));
+
+    auto* firstRoot = first.retainNode(1);
+    auto* secondRoot = second.retainNode(2);
+    EXPECT_EQ(first.appendChild(firstRoot, 10, TreeNodeSide::Left), OperationResult::Success);
+    EXPECT_EQ(second.appendChild(secondRoot, 20, TreeNodeSide::Left), OperationResult::Success);
+
+    // プール全体が埋まっている
+    EXPECT_EQ(first.appendChild(firstRoot, 11, TreeNodeSide::Right), OperationResult::Overflow);
+    EXPECT_EQ(pool.amount(), 4);
+
+    // 一方で返却したノードを他方で使える
+    auto* leaf = secondRoot->lhs;
+    secondRoot->lhs = nullptr;
+    second.removeChild(leaf);
+    EXPECT_EQ(pool.amount(), 3);
+    EXPECT_EQ(first.appendChild(firstRoot, 11, TreeNodeSide::Right), OperationResult::Success);
+    EXPECT_EQ(firstRoot->rhs->element, 11);
+}
+
+namespace {
+using CountedNode = TreeNode<int, size_t, true, SubtreeSize>;
+using CountedTree = Tree<int, size_t, true, SubtreeSize>;
+
+/// 二分探索木として要素を追加する
+CountedNode* insertSorted(CountedTree& tree, CountedNode* root, const int value) {
+    auto* node = root;
+    while (true) {
+        const auto side = value < node->element ? TreeNodeSide::Left : TreeNodeSide::Right;
+        auto* next = side == TreeNodeSide::Left ? node->lhs : node->rhs;
+        if (next == nullptr) {
+            CountedNode* added = nullptr;
+            tree.appendChild(node, value, side, &added);
+            return added;
+        }
+        node = next;
+    }
+}
+}  // namespace
+
+TEST(TreeTest, testOrderStatistics) {
+    CountedNode nodePool[64];
+    CountedTree tree(nodePool, 64);
+
+    // 順不同に追加した二分探索木で、順位による参照と順位の計算を行う
+    std::vector<int> sorted;
+    auto* root = tree.retainNode(500);
+    sorted.push_back(500);
+    uint32_t seed = 11;
+    for (int i = 0; i < 40; i++) {
+        seed = seed * 1103515245 + 12345;
+        const int value = static_cast<int>((seed >> 16) % 1000);
+        insertSorted(tree, root, value);
+        sorted.insert(std::upper_bound(sorted.begin(), sorted.end(), value), value);
+    }
+    EXPECT_EQ(CountedTree::subtreeSizeOf(root), sorted.size());
+
+    for (size_t k = 0; k < sorted.size(); k++) {
+        auto* node = tree.select(root, k);
+        ASSERT_NE(node, nullptr);
+        EXPECT_EQ(node->element, sorted[k]);
+        EXPECT_EQ(tree.countLess(root, sorted[k]), std::lower_bound(sorted.begin(), sorted.end(), sorted[k]) - sorted.begin());
+    }
+    EXPECT_EQ(tree.select(root, sorted.size()), nullptr);
+    EXPECT_EQ(tree.countLess(root, 1000), sorted.size());
+
+    // 回転しても順位は変わらない
+    auto* pivot = tree.rotateLeft(root);
+    ASSERT_NE(pivot, nullptr);
+    root = pivot;
+    for (size_t k = 0; k < sorted.size(); k++) {
+        auto* node = tree.select(root, k);
+        EXPECT_EQ(node->element, sorted[k]);
+        EXPECT_EQ(tree.rank(node), k);
+    }
+
+    // リーフを削除すると、祖先の部分木のノード数も減る
+    auto* leaf = tree.select(root, 0);
+    while (!leaf->isLeaf()) {
+        leaf = leaf->lhs != nullptr ? leaf->lhs : leaf->rhs;
+    }
+    tree.removeChild(leaf);
+    EXPECT_EQ(CountedTree::subtreeSizeOf(root), sorted.size() - 1);
+    EXPECT_EQ(sizeof(TreeNode<int, size_t, true>), sizeof(CountedNode) - sizeof(size_t));
+}
+
+namespace {
+struct SumMonoid {
+    using Value = long;
+    static Value identity() {
+        return 0;
+    }
+    static Value of(const int& element) {
+        return element;
+    }
+    static Value combine(const Value& lhs, const Value& rhs) {
+        return lhs + rhs;
+    }
+};
+}  // namespace
+
+TEST(TreeTest, testSubtreeAggregate) {
+    using Node = TreeNode<int, size_t, true, SubtreeAggregate<SumMonoid>>;
+    Node nodePool[8];
+    Tree<int, size_t, true, SubtreeAggregate<SumMonoid>> tree(nodePool, 8);
+
+    auto* root = tree.retainNode(10);
+    Node* left = nullptr;
+    tree.appendChild(root, 5, TreeNodeSide::Left, &left);
+    tree.appendChild(root, 20, TreeNodeSide::Right);
+    tree.appendChild(left, 1, TreeNodeSide::Left);
+    EXPECT_EQ(root->aggregate, 36);
+    EXPECT_EQ(root->subtreeSize, 4);
+    EXPECT_EQ(left->aggregate, 6);
+
+    // 要素を書き換えたら、根まで計算し直す
+    left->element = 7;
+    tree.updateAugmentation(left);
+    EXPECT_EQ(root->aggregate, 38);
+
+    // 子孫をまとめて削除すると、全てプールへ返却される
+    tree.removeChild(root);
+    EXPECT_EQ(root->aggregate, 10);
+    EXPECT_EQ(root->subtreeSize, 1);
+    EXPECT_EQ(tree.amount(), 1);
+}
+
+namespace {
+/// 部分木の高さを求める
+template <typename Node>
+size_t heightOf(const Node* node) {
+    if (node == nullptr) {
+        return 0;
+    }
+    return 1 + std::max(heightOf(node->lhs), heightOf(node->rhs));
+}
+
+/// 中間順に要素を書き出す
+template <typename Node>
+void collectInOrder(const Node* node, std::vector<int>& destination) {
+    if (node == nullptr) {
+        return;
+    }
+    collectInOrder(node->lhs, destination);
+    destination.push_back(node->element);
+    collectInOrder(node->rhs, destination);
+}
+}  // namespace
+
+TEST(TreeTest, testBuildBalanced) {
+    const size_t length = 1000;
+    std::vector<int> sorted(length);
+    for (size_t i = 0; i < length; i++) {
+        sorted[i] = static_cast<int>(i * 3);
+    }
+
+    std::vector<TreeNode<int>> nodePool(length);
+    Tree<int> tree(nodePool.data(), length);
+    TreeNode<int>* root = nullptr;
+    EXPECT_EQ(tree.buildBalanced(sorted.data(), length, &root), OperationResult::Success);
+    ASSERT_NE(root, nullptr);
+    EXPECT_EQ(tree.amount(), length);
+
+    // 中間順に辿ると元の配列と一致し、高さは最小になる
+    std::vector<int> inOrder;
+    collectInOrder(root, inOrder);
+    EXPECT_EQ(inOrder, sorted);
+    EXPECT_EQ(heightOf(root), 10);
+
+    // ノードは要素と同じ順序で領域に並ぶ
+    for (size_t i = 0; i < length; i++) {
+        EXPECT_EQ(nodePool[i].element, sorted[i]);
+    }
+
+    // 空きが足りなければ何もしない
+    EXPECT_EQ(tree.buildBalanced(sorted.data(), 1, &root), OperationResult::Overflow);
+    EXPECT_EQ(tree.buildBalanced(sorted.data(), 0, &root), OperationResult::Empty);
+}
+
+TEST(TreeTest, testBuildBalancedWithAugmentation) {
+    const int sorted[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+    CountedNode nodePool[16];
+    CountedTree tree(nodePool, 16);
+    CountedNode* root = nullptr;
+    EXPECT_EQ(tree.buildBalanced(sorted, 12, &root), OperationResult::Success);
+
+    // 親へのリンクと部分木のノード数も同時に設定される
+    EXPECT_EQ(root->parent, nullptr);
+    EXPECT_EQ(root->lhs->parent, root);
+    EXPECT_EQ(CountedTree::subtreeSizeOf(root), 12);
+    for (size_t k = 0; k < 12; k++) {
+        auto* node = tree.select(root, k);
+        EXPECT_EQ(node->element, sorted[k]);
+        EXPECT_EQ(tree.rank(node), k);
+    }
+}
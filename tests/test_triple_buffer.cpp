@@ -0,0 +1,122 @@
+//
+// トリプルバッファのテスト
+//
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <thread>
+
+#include "collection2/interrupt.hpp"
+#include "collection2/triple_buffer.hpp"
+
+using namespace collection2;
+
+TEST(TripleBufferTest, testLatestValueWins) {
+    int data[3] = {0};
+    TripleBuffer<int> buffer(data);
+
+    // 公開されるまでは何も受け取れない
+    int value = 0;
+    EXPECT_FALSE(buffer.hasUpdate());
+    EXPECT_EQ(buffer.read(&value), OperationResult::Empty);
+
+    // 取り出す前に何度公開しても、受け取るのは最後の値だけ
+    for (int i = 1; i <= 5; i++) {
+        EXPECT_EQ(buffer.write(i), OperationResult::Success);
+    }
+    EXPECT_TRUE(buffer.hasUpdate());
+    EXPECT_EQ(buffer.read(&value), OperationResult::Success);
+    EXPECT_EQ(value, 5);
+    EXPECT_EQ(buffer.read(&value), OperationResult::Empty);
+
+    // 受け取った値は、次に更新するまで書き換えられない
+    EXPECT_TRUE(buffer.update() == false);
+    buffer.write(6);
+    buffer.write(7);
+    buffer.write(8);
+    EXPECT_EQ(buffer.readSlot(), 5);
+    EXPECT_TRUE(buffer.update());
+    EXPECT_EQ(buffer.readSlot(), 8);
+}
+
+TEST(TripleBufferTest, testWriteInPlace) {
+    struct Frame {
+        int sequence;
+        int samples[4];
+    };
+    Frame frames[3] = {};
+    TripleBuffer<Frame> buffer(frames);
+
+    // 追加側の領域に直接書き込んでから公開する
+    for (int sequence = 1; sequence <= 3; sequence++) {
+        Frame* frame = buffer.writeSlot();
+        frame->sequence = sequence;
+        for (int i = 0; i < 4; i++) {
+            frame->samples[i] = sequence * 10 + i;
+        }
+        buffer.publish();
+
+        ASSERT_TRUE(buffer.update());
+        EXPECT_EQ(buffer.readSlot().sequence, sequence);
+        EXPECT_EQ(buffer.readSlot().samples[3], sequence * 10 + 3);
+    }
+
+    // 3つの領域はそれぞれ別の役割を持つ
+    EXPECT_NE(buffer.writeSlot(), &buffer.readSlot());
+}
+
+TEST(TripleBufferTest, testInterruptPolicy) {
+    int data[3] = {0};
+    TripleBuffer<int, InterruptToMain> buffer(data);
+
+    buffer.write(1);
+    buffer.write(2);
+    int value = 0;
+    EXPECT_EQ(buffer.read(&value), OperationResult::Success);
+    EXPECT_EQ(value, 2);
+    EXPECT_EQ(buffer.read(&value), OperationResult::Empty);
+}
+
+TEST(TripleBufferTest, testConcurrentExchange) {
+    struct Frame {
+        int sequence;
+        int copies[15];
+    };
+    Frame frames[3] = {};
+    TripleBuffer<Frame, LockFree> buffer(frames);
+    const int frameCount = 200000;
+
+    std::thread producer([&]() {
+        for (int sequence = 1; sequence <= frameCount; sequence++) {
+            Frame* frame = buffer.writeSlot();
+            frame->sequence = sequence;
+            for (auto& copy : frame->copies) {
+                copy = sequence;
+            }
+            buffer.publish();
+        }
+    });
+
+    // 受け取るフレームは常に書き込みが完了したもので、新しくなる一方である
+    int lastSequence = 0;
+    int torn = 0;
+    int regressed = 0;
+    while (lastSequence < frameCount) {
+        if (!buffer.update()) {
+            continue;
+        }
+        const Frame& frame = buffer.readSlot();
+        for (const auto& copy : frame.copies) {
+            torn += copy != frame.sequence ? 1 : 0;
+        }
+        regressed += frame.sequence <= lastSequence ? 1 : 0;
+        lastSequence = frame.sequence;
+    }
+    producer.join();
+
+    EXPECT_EQ(torn, 0);
+    EXPECT_EQ(regressed, 0);
+    EXPECT_FALSE(buffer.hasUpdate());
+}
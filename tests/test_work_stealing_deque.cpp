@@ -0,0 +1,135 @@
+//
+// ワークスティーリング両端キューのテスト
+//
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <thread>
+
+#include "collection2/work_stealing_deque.hpp"
+
+using namespace collection2;
+
+TEST(WorkStealingDequeTest, testCapacityAndAmount) {
+    std::atomic<int> data[10];
+    WorkStealingDeque<int> deque(data, 10);
+
+    EXPECT_EQ(deque.capacity(), 8);
+
+    deque.push(1);
+    deque.push(2);
+    deque.push(3);
+
+    EXPECT_EQ(deque.amount(), 3);
+}
+
+TEST(WorkStealingDequeTest, testOperate) {
+    const int dequeLength = 8;
+    std::atomic<int> dequeData[dequeLength];
+    WorkStealingDeque<int, uint8_t> deque(dequeData, dequeLength);
+
+    // インデックスが何周しても正しく動作する
+    for (int round = 0; round < 100; round++) {
+        for (int i = 0; i < dequeLength; i++) {
+            EXPECT_EQ(deque.push(i + 1), OperationResult::Success);
+        }
+        EXPECT_EQ(deque.push(0), OperationResult::Overflow);
+
+        // 所有者は後入れ先出し、盗みは先入れ先出し
+        int value = 0;
+        EXPECT_EQ(deque.pop(&value), OperationResult::Success);
+        EXPECT_EQ(value, dequeLength);
+        EXPECT_EQ(deque.steal(&value), OperationResult::Success);
+        EXPECT_EQ(value, 1);
+        for (int i = dequeLength - 1; i > 1; i--) {
+            EXPECT_EQ(deque.pop(&value), OperationResult::Success);
+            EXPECT_EQ(value, i);
+        }
+
+        EXPECT_TRUE(deque.isEmpty());
+        EXPECT_EQ(deque.pop(&value), OperationResult::Empty);
+        EXPECT_EQ(deque.steal(&value), OperationResult::Empty);
+    }
+}
+
+TEST(WorkStealingDequeTest, testOperateWithZeroSize) {
+    WorkStealingDeque<int> deque(nullptr, 0);
+
+    int value = 1;
+    EXPECT_EQ(deque.push(value), OperationResult::Overflow);
+    EXPECT_EQ(deque.pop(&value), OperationResult::Empty);
+    EXPECT_EQ(deque.steal(&value), OperationResult::Empty);
+}
+
+TEST(WorkStealingDequeTest, testConcurrentSteal) {
+    const int dequeLength = 256;
+    const int taskCount = 100000;
+    const int thiefCount = 3;
+    std::atomic<int> dequeData[dequeLength];
+    WorkStealingDeque<int> deque(dequeData, dequeLength);
+
+    // 各タスクがちょうど一度だけ取り出されることを確認する
+    static std::atomic<int> taken[taskCount];
+    for (auto& count : taken) {
+        count.store(0);
+    }
+    std::atomic<int> takenCount(0);
+
+    std::thread thieves[thiefCount];
+    for (auto& thief : thieves) {
+        thief = std::thread([&]() {
+            while (takenCount.load() < taskCount) {
+                int value = 0;
+                if (deque.steal(&value) == OperationResult::Success) {
+                    taken[value]++;
+                    takenCount++;
+                }
+            }
+        });
+    }
+
+    // 所有者はタスクを積みつつ、自分でも取り出す
+    for (int i = 0; i < taskCount; i++) {
+        while (deque.push(i) != OperationResult::Success) {
+            int value = 0;
+            if (deque.pop(&value) == OperationResult::Success) {
+                taken[value]++;
+                takenCount++;
+            }
+        }
+        if (i % 3 == 0) {
+            int value = 0;
+            if (deque.pop(&value) == OperationResult::Success) {
+                taken[value]++;
+                takenCount++;
+            }
+        }
+    }
+    int clobbered = 0;
+    while (takenCount.load() < taskCount) {
+        // 盗みに負けた場合、格納先は書き換えられない
+        int value = -1;
+        if (deque.pop(&value) == OperationResult::Success) {
+            taken[value]++;
+            takenCount++;
+        } else {
+            clobbered += value != -1 ? 1 : 0;
+        }
+    }
+    for (auto& thief : thieves) {
+        thief.join();
+    }
+
+    int duplicated = 0;
+    int missing = 0;
+    for (auto& count : taken) {
+        duplicated += count.load() > 1 ? 1 : 0;
+        missing += count.load() == 0 ? 1 : 0;
+    }
+    EXPECT_EQ(duplicated, 0);
+    EXPECT_EQ(missing, 0);
+    EXPECT_EQ(clobbered, 0);
+    EXPECT_TRUE(deque.isEmpty());
+}
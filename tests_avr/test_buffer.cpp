@@ -2,6 +2,8 @@
 // バッファのテスト
 //
 
+#include <stdint.h>
+
 #include "collection2/buffer.hpp"
 #include "testcase.hpp"
 
@@ -114,14 +116,34 @@ TEST(testOperateWithOneSize) {
     EndTestcase(result);
 }
 
+TEST(testExactCapacity) {
+    BeginTestcase(result);
+    // 領域全体が容量として使用され、満杯なら先頭から上書きされる
+    int bufferData[12] = {0};
+    Buffer<int, uint8_t, SingleContext, ExactCapacity> buffer(bufferData, 12);
+    EXPECT_EQ(buffer.capacity(), 12, result);
+
+    for (int i = 0; i < 20; i++) {
+        EXPECT_EQ(buffer.append(i), OperationResult::Success, result);
+    }
+    for (int i = 8; i < 20; i++) {
+        int value = 0;
+        EXPECT_EQ(buffer.pop(&value), OperationResult::Success, result);
+        EXPECT_EQ(value, i, result);
+    }
+    EXPECT_TRUE(buffer.isEmpty(), result);
+    EndTestcase(result);
+}
+
 const TestFunction tests[] = {
     testInstantiate,
     testOperateWithOrdinallySize,
     testOperateWithExceptionalSize,
     testOperateWithZeroSize,
     testOperateWithOneSize,
+    testExactCapacity,
 };
 
-const size_t testCount = 5;
+const size_t testCount = 6;
 
 }  // namespace collection2tests
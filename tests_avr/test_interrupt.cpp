@@ -0,0 +1,128 @@
+//
+// 割り込みハンドラと共有するキュー・リングバッファのテスト
+//
+
+#include <stdint.h>
+
+#include "collection2/interrupt.hpp"
+#include "testcase.hpp"
+
+using namespace collection2;
+
+namespace collection2tests {
+
+TEST(testInterruptGuard) {
+    BeginTestcase(result);
+    // 割り込み許可状態は、ガードを抜けると元に戻る
+    sei();
+    {
+        InterruptGuard guard;
+        EXPECT_FALSE(SREG & _BV(SREG_I), result);
+    }
+    EXPECT_TRUE(SREG & _BV(SREG_I), result);
+
+    cli();
+    {
+        InterruptGuard guard;
+    }
+    EXPECT_FALSE(SREG & _BV(SREG_I), result);
+    sei();
+    EndTestcase(result);
+}
+
+TEST(testQueueWrapAround) {
+    BeginTestcase(result);
+    // 1バイトのインデックスが何周しても正しく動作する
+    char data[64] = {0};
+    Queue<char, uint8_t, InterruptToMain> queue(data, sizeof(data));
+    EXPECT_EQ(queue.capacity(), 64, result);
+
+    for (int round = 0; round < 10; round++) {
+        for (int i = 0; i < 64; i++) {
+            EXPECT_EQ(queue.enqueue(static_cast<char>(round + i)), OperationResult::Success, result);
+        }
+        EXPECT_EQ(queue.enqueue(0), OperationResult::Overflow, result);
+
+        for (int i = 0; i < 64; i++) {
+            char value = 0;
+            EXPECT_EQ(queue.dequeue(&value), OperationResult::Success, result);
+            EXPECT_EQ(value, static_cast<char>(round + i), result);
+        }
+        EXPECT_TRUE(queue.isEmpty(), result);
+    }
+    EndTestcase(result);
+}
+
+TEST(testQueueConsume) {
+    BeginTestcase(result);
+    char data[16] = {0};
+    Queue<char, uint8_t, InterruptToMain> queue(data, sizeof(data));
+
+    // 1バイトのインデックスが何周しても、まとめて処理できる
+    char expected = 0;
+    bool isOrdered = true;
+    for (int round = 0; round < 40; round++) {
+        for (int i = 0; i < 10; i++) {
+            queue.enqueue(static_cast<char>(round * 10 + i));
+        }
+        EXPECT_EQ(queue.consume(4, [&](char& value) { isOrdered = isOrdered && value == expected++; }), 4, result);
+        EXPECT_EQ(queue.consumeAll([&](char& value) { isOrdered = isOrdered && value == expected++; }), 6, result);
+    }
+    EXPECT_TRUE(isOrdered, result);
+    EXPECT_TRUE(queue.isEmpty(), result);
+    EndTestcase(result);
+}
+
+TEST(testBufferOverwrite) {
+    BeginTestcase(result);
+    int data[4] = {0};
+    Buffer<int, uint16_t, MainToInterrupt> buffer(data, 4);
+
+    // 満杯で追加すると古いものから捨てられる
+    for (int i = 0; i < 6; i++) {
+        EXPECT_EQ(buffer.append(i + 1), OperationResult::Success, result);
+    }
+    EXPECT_EQ(buffer.amount(), 4, result);
+
+    for (int i = 2; i < 6; i++) {
+        int value = 0;
+        EXPECT_EQ(buffer.pop(&value), OperationResult::Success, result);
+        EXPECT_EQ(value, i + 1, result);
+    }
+    EXPECT_EQ(buffer.pop(nullptr), OperationResult::Empty, result);
+    EndTestcase(result);
+}
+
+TEST(testExactCapacity) {
+    BeginTestcase(result);
+    // 領域全体を使用し、インデックスは容量の2倍の範囲を巡回する
+    char data[12] = {0};
+    Queue<char, uint8_t, InterruptToMain, ExactCapacity> queue(data, sizeof(data));
+    EXPECT_EQ(queue.capacity(), 12, result);
+
+    for (int round = 0; round < 30; round++) {
+        for (int i = 0; i < 12; i++) {
+            EXPECT_EQ(queue.enqueue(static_cast<char>(round + i)), OperationResult::Success, result);
+        }
+        EXPECT_EQ(queue.enqueue(0), OperationResult::Overflow, result);
+        for (int i = 0; i < 12; i++) {
+            char value = 0;
+            EXPECT_EQ(queue.dequeue(&value), OperationResult::Success, result);
+            EXPECT_EQ(value, static_cast<char>(round + i), result);
+        }
+    }
+    EXPECT_TRUE(queue.isEmpty(), result);
+    EndTestcase(result);
+}
+
+const TestFunction tests[] = {
+    testInterruptGuard,
+    testQueueWrapAround,
+    testQueueConsume,
+    testBufferOverwrite,
+    testExactCapacity,
+};
+
+const size_t testCount = 5;
+
+}  // namespace collection2tests
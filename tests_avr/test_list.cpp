@@ -240,6 +240,80 @@ TEST(testOperateWithOneSize) {
     EndTestcase(result);
 }
 
+// ソート
+TEST(testSort) {
+    BeginTestcase(result);
+    const int listLength = 50;
+    Node<int> listData[listLength];
+    List<int> list(listData, listLength);
+
+    // 適当な順番で追加
+    for (int i = 0; i < listLength; i++) {
+        list.append((i * 37) % listLength);
+    }
+
+    list.sort();
+
+    // 前から辿っても後ろから辿っても整列している
+    auto* node = list.head();
+    for (int i = 0; i < listLength; i++) {
+        EXPECT_EQ(node->element, i, result);
+        node = node->next;
+    }
+    EXPECT_EQ(node, nullptr, result);
+
+    node = list.tail();
+    for (int i = listLength - 1; i >= 0; i--) {
+        EXPECT_EQ(node->element, i, result);
+        node = node->previous;
+    }
+    EXPECT_EQ(node, nullptr, result);
+    EndTestcase(result);
+}
+
+// 整列済みリストへの追加
+TEST(testInsertSorted) {
+    BeginTestcase(result);
+    const int listLength = 10;
+    Node<int> listData[listLength];
+    List<int> list(listData, listLength);
+
+    int values[] = {5, 1, 9, 3, 7, 3, 0, 8, 2, 6};
+    for (int i = 0; i < listLength; i++) {
+        EXPECT_EQ(list.insertSorted(values[i]), OperationResult::Success, result);
+    }
+    EXPECT_EQ(list.insertSorted(4), OperationResult::Overflow, result);
+
+    int expected[] = {0, 1, 2, 3, 3, 5, 6, 7, 8, 9};
+    for (int i = 0; i < listLength; i++) {
+        EXPECT_EQ(*list.get(i), expected[i], result);
+    }
+    EndTestcase(result);
+}
+
+TEST(testSharedPool) {
+    BeginTestcase(result);
+    // 4本のリストで8ノードを共有する
+    Node<int> nodes[8];
+    Pool<Node<int>> pool(nodes, 8);
+    List<int, size_t, SharedPool> channel0(pool), channel1(pool), channel2(pool), channel3(pool);
+    List<int, size_t, SharedPool>* lists[] = {&channel0, &channel1, &channel2, &channel3};
+
+    for (int i = 0; i < 6; i++) {
+        EXPECT_EQ(lists[0]->append(i), OperationResult::Success, result);
+    }
+    EXPECT_EQ(lists[1]->append(100), OperationResult::Success, result);
+    EXPECT_EQ(lists[2]->append(200), OperationResult::Success, result);
+    EXPECT_EQ(lists[3]->append(300), OperationResult::Overflow, result);
+
+    // 返却したノードは他のリストで再利用できる
+    lists[0]->clear();
+    EXPECT_EQ(pool.amount(), 2, result);
+    EXPECT_EQ(lists[3]->append(300), OperationResult::Success, result);
+    EXPECT_EQ(*lists[3]->get(0), 300, result);
+    EndTestcase(result);
+}
+
 const TestFunction tests[] = {
     testChainAccess,
     testCapacityAndAmount,
@@ -251,8 +325,11 @@ const TestFunction tests[] = {
     testAdditionAndDeletion,
     testOperateWithZeroSize,
     testOperateWithOneSize,
+    testSort,
+    testInsertSorted,
+    testSharedPool,
 };
 
-const size_t testCount = 10;
+const size_t testCount = 13;
 
 }  // namespace collection2tests
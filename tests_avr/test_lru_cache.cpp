@@ -0,0 +1,66 @@
+//
+// LRUキャッシュのテスト
+//
+
+#include <stdint.h>
+
+#include "collection2/lru_cache.hpp"
+#include "testcase.hpp"
+
+using namespace collection2;
+
+namespace collection2tests {
+
+TEST(testGetAndPut) {
+    BeginTestcase(result);
+    LruCacheNode<uint16_t, int, uint8_t> nodes[3];
+    uint8_t table[8];
+    LruCache<uint16_t, int, uint8_t> cache(nodes, 3, table, 8);
+
+    EXPECT_EQ(cache.put(1, 10), OperationResult::Success, result);
+    EXPECT_EQ(cache.put(2, 20), OperationResult::Success, result);
+    EXPECT_EQ(cache.put(3, 30), OperationResult::Success, result);
+    EXPECT_EQ(*cache.get(1), 10, result);
+
+    // 最も長く使われていない2が追い出される
+    EXPECT_EQ(cache.put(4, 40), OperationResult::Success, result);
+    EXPECT_EQ(cache.amount(), 3, result);
+    EXPECT_EQ(cache.get(2), nullptr, result);
+    EXPECT_EQ(*cache.get(3), 30, result);
+    EXPECT_EQ(cache.head()->element.key, 1, result);
+
+    EXPECT_EQ(cache.remove(3), OperationResult::Success, result);
+    EXPECT_EQ(cache.remove(3), OperationResult::Empty, result);
+    EndTestcase(result);
+}
+
+int evictedKey = 0;
+
+void recordEviction(const uint16_t& key, int&, void*) {
+    evictedKey = key;
+}
+
+TEST(testEvictionCallback) {
+    BeginTestcase(result);
+    LruCacheNode<uint16_t, int, uint8_t> nodes[2];
+    uint8_t table[4];
+    LruCache<uint16_t, int, uint8_t> cache(nodes, 2, table, 4);
+    cache.setEvictionCallback(recordEviction);
+
+    cache.put(1, 1);
+    cache.put(2, 2);
+    cache.get(1);
+    cache.put(3, 3);
+    EXPECT_EQ(evictedKey, 2, result);
+    EXPECT_EQ(*cache.peek(1), 1, result);
+    EndTestcase(result);
+}
+
+const TestFunction tests[] = {
+    testGetAndPut,
+    testEvictionCallback,
+};
+
+const size_t testCount = sizeof(tests) / sizeof(TestFunction);
+
+}  // namespace collection2tests
@@ -0,0 +1,68 @@
+//
+// 永続化キュー・リングバッファのテスト
+//
+
+#include <stdint.h>
+
+#include "collection2/persistent.hpp"
+#include "testcase.hpp"
+
+using namespace collection2;
+
+namespace collection2tests {
+
+TEST(testQueueRestore) {
+    BeginTestcase(result);
+    unsigned char region[64] = {0};
+    {
+        PersistentQueue<int, uint8_t> queue(region, sizeof(region));
+        EXPECT_FALSE(queue.isRestored(), result);
+        for (int i = 0; i < 5; i++) {
+            EXPECT_EQ(queue.enqueue(i + 1), OperationResult::Success, result);
+        }
+    }
+
+    // 同じ領域を渡すと、続きから復元される
+    PersistentQueue<int, uint8_t> queue(region, sizeof(region));
+    EXPECT_TRUE(queue.isRestored(), result);
+    EXPECT_EQ(queue.amount(), 5, result);
+    for (int i = 0; i < 5; i++) {
+        int value = 0;
+        EXPECT_EQ(queue.dequeue(&value), OperationResult::Success, result);
+        EXPECT_EQ(value, i + 1, result);
+    }
+    EXPECT_TRUE(queue.isEmpty(), result);
+    EndTestcase(result);
+}
+
+TEST(testBufferOverwrite) {
+    BeginTestcase(result);
+    unsigned char region[sizeof(internal::PersistentRingHeader<uint8_t>) + sizeof(int) * 4];
+    {
+        PersistentBuffer<int, uint8_t> buffer(region, sizeof(region));
+        EXPECT_EQ(buffer.capacity(), 4, result);
+        for (int i = 0; i < 6; i++) {
+            EXPECT_EQ(buffer.append(i + 1), OperationResult::Success, result);
+        }
+    }
+
+    // 満杯で追加した分は古いものから捨てられている
+    PersistentBuffer<int, uint8_t> buffer(region, sizeof(region));
+    EXPECT_TRUE(buffer.isRestored(), result);
+    for (int i = 2; i < 6; i++) {
+        int value = 0;
+        EXPECT_EQ(buffer.pop(&value), OperationResult::Success, result);
+        EXPECT_EQ(value, i + 1, result);
+    }
+    EXPECT_EQ(buffer.pop(nullptr), OperationResult::Empty, result);
+    EndTestcase(result);
+}
+
+const TestFunction tests[] = {
+    testQueueRestore,
+    testBufferOverwrite,
+};
+
+const size_t testCount = sizeof(tests) / sizeof(TestFunction);
+
+}  // namespace collection2tests
@@ -0,0 +1,86 @@
+//
+// オブジェクトプールのテスト
+//
+
+#include "collection2/pool.hpp"
+#include "testcase.hpp"
+
+using namespace collection2;
+
+namespace collection2tests {
+
+TEST(testCapacityAndAmount) {
+    BeginTestcase(result);
+    int data[10] = {0};
+    Pool<int, unsigned int> pool(data, 10);
+
+    EXPECT_EQ(pool.capacity(), 10, result);
+    EXPECT_TRUE(pool.isEmpty(), result);
+
+    pool.acquire(1);
+    pool.acquire(2);
+    pool.acquire(3);
+
+    EXPECT_EQ(pool.amount(), 3, result);
+    EndTestcase(result);
+}
+
+TEST(testAcquireAndRelease) {
+    BeginTestcase(result);
+    const int poolLength = 16;
+    int poolData[poolLength] = {0};
+    Pool<int, unsigned int> pool(poolData, poolLength);
+
+    // プールの長さだけ払い出す
+    int* objects[poolLength] = {nullptr};
+    for (int i = 0; i < poolLength; i++) {
+        objects[i] = pool.acquire(i + 1);
+        EXPECT_NE(objects[i], nullptr, result);
+    }
+
+    // 範囲外の払い出し
+    EXPECT_EQ(pool.acquire(), nullptr, result);
+
+    // 返却したスロットは再利用される
+    EXPECT_EQ(pool.release(objects[3]), OperationResult::Success, result);
+    EXPECT_EQ(pool.release(objects[7]), OperationResult::Success, result);
+    EXPECT_EQ(pool.acquire(100), objects[7], result);
+    EXPECT_EQ(pool.acquire(200), objects[3], result);
+    EXPECT_EQ(*objects[7], 100, result);
+    EXPECT_EQ(*objects[3], 200, result);
+    EndTestcase(result);
+}
+
+TEST(testReleaseForeignObject) {
+    BeginTestcase(result);
+    int poolData[4] = {0};
+    Pool<int, unsigned int> pool(poolData, 4);
+
+    int foreign = 0;
+    pool.acquire(1);
+    EXPECT_EQ(pool.release(&foreign), OperationResult::Empty, result);
+    EXPECT_EQ(pool.release(nullptr), OperationResult::Empty, result);
+    EXPECT_EQ(pool.amount(), 1, result);
+    EndTestcase(result);
+}
+
+TEST(testOperateWithZeroSize) {
+    BeginTestcase(result);
+    Pool<int, unsigned int> pool(nullptr, 0);
+
+    EXPECT_EQ(pool.acquire(), nullptr, result);
+    int value = 0;
+    EXPECT_EQ(pool.release(&value), OperationResult::Empty, result);
+    EndTestcase(result);
+}
+
+const TestFunction tests[] = {
+    testCapacityAndAmount,
+    testAcquireAndRelease,
+    testReleaseForeignObject,
+    testOperateWithZeroSize,
+};
+
+const size_t testCount = sizeof(tests) / sizeof(TestFunction);
+
+}  // namespace collection2tests
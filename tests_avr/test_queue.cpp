@@ -2,6 +2,8 @@
 // キューのテスト
 //
 
+#include <stdint.h>
+
 #include "collection2/queue.hpp"
 #include "testcase.hpp"
 
@@ -130,6 +132,95 @@ TEST(testOperateWithOneSize) {
     EndTestcase(result);
 }
 
+TEST(testEnqueueAndDequeueN) {
+    BeginTestcase(result);
+    int queueData[8] = {0};
+    Queue<int> queue(queueData, 8);
+
+    // 折り返し位置の手前まで進めておく
+    const int prefix[] = {-1, -2, -3, -4, -5, -6};
+    int discarded[6] = {0};
+    EXPECT_EQ(queue.enqueueN(prefix, 6), OperationResult::Success, result);
+    EXPECT_EQ(queue.dequeueN(discarded, 6), OperationResult::Success, result);
+
+    // 折り返しをまたいで追加・取り出しができる
+    const int values[] = {1, 2, 3, 4, 5};
+    EXPECT_EQ(queue.enqueueN(values, 5), OperationResult::Success, result);
+    EXPECT_EQ(queue.enqueueN(values, 4), OperationResult::Overflow, result);
+
+    int received[5] = {0};
+    EXPECT_EQ(queue.dequeueN(received, 6), OperationResult::Empty, result);
+    EXPECT_EQ(queue.dequeueN(received, 5), OperationResult::Success, result);
+    for (int i = 0; i < 5; i++) {
+        EXPECT_EQ(received[i], values[i], result);
+    }
+    EXPECT_TRUE(queue.isEmpty(), result);
+    EndTestcase(result);
+}
+
+TEST(testConsume) {
+    BeginTestcase(result);
+    int queueData[8] = {0};
+    Queue<int> queue(queueData, 8);
+    for (int i = 0; i < 6; i++) {
+        queue.enqueue(i);
+    }
+    int discarded = 0;
+    queue.dequeue(&discarded);
+
+    // 指定した数だけ、先頭から順にコールバックへ渡される
+    int sum = 0;
+    EXPECT_EQ(queue.consume(2, [&sum](int& value) { sum += value; }), 2, result);
+    EXPECT_EQ(sum, 1 + 2, result);
+
+    // 折り返しをまたいで全て処理する
+    for (int i = 6; i < 10; i++) {
+        queue.enqueue(i);
+    }
+    int expected = 3;
+    bool isOrdered = true;
+    EXPECT_EQ(queue.consumeAll([&](int& value) { isOrdered = isOrdered && value == expected++; }), 7, result);
+    EXPECT_TRUE(isOrdered, result);
+    EXPECT_TRUE(queue.isEmpty(), result);
+    EndTestcase(result);
+}
+
+TEST(testExactCapacity) {
+    BeginTestcase(result);
+    // 領域全体が容量として使用される
+    int queueData[10] = {0};
+    Queue<int, uint8_t, SingleContext, ExactCapacity> queue(queueData, 10);
+    EXPECT_EQ(queue.capacity(), 10, result);
+
+    // 折り返しをまたいで順序が保たれる
+    int value = 0;
+    for (int round = 0; round < 3; round++) {
+        for (int i = 0; i < 7; i++) {
+            EXPECT_EQ(queue.enqueue(round * 10 + i), OperationResult::Success, result);
+        }
+        for (int i = 0; i < 7; i++) {
+            EXPECT_EQ(queue.dequeue(&value), OperationResult::Success, result);
+            EXPECT_EQ(value, round * 10 + i, result);
+        }
+    }
+    for (int i = 0; i < 10; i++) {
+        EXPECT_EQ(queue.enqueue(i), OperationResult::Success, result);
+    }
+    EXPECT_EQ(queue.enqueue(10), OperationResult::Overflow, result);
+    EndTestcase(result);
+}
+
+int constantQueueData[10];
+constexpr Queue<int> constantQueue(constantQueueData, 10);
+
+TEST(testConstantInitialization) {
+    BeginTestcase(result);
+    // 容量の計算はコンパイル時に行われる
+    static_assert(constantQueue.capacity() == 8, "capacity must be computed at compile time");
+    EXPECT_TRUE(constantQueue.isEmpty(), result);
+    EndTestcase(result);
+}
+
 const TestFunction tests[] = {
     testInstantiate,
     testCapacityAndAmount,
@@ -137,8 +228,12 @@ const TestFunction tests[] = {
     testOperateWithExceptionalSize,
     testOperateWithZeroSize,
     testOperateWithOneSize,
+    testConstantInitialization,
+    testEnqueueAndDequeueN,
+    testConsume,
+    testExactCapacity,
 };
 
-const size_t testCount = 6;
+const size_t testCount = 10;
 
 }  // namespace collection2tests
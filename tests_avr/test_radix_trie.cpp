@@ -0,0 +1,56 @@
+//
+// 基数木のテスト
+//
+
+#include "collection2/radix_trie.hpp"
+#include "testcase.hpp"
+
+using namespace collection2;
+
+namespace collection2tests {
+
+TEST(testInsertAndFind) {
+    BeginTestcase(result);
+    RadixTrieNode<int> nodes[16];
+    RadixTrie<int> trie(nodes, 16);
+
+    EXPECT_EQ(trie.insert("romane", 1), OperationResult::Success, result);
+    EXPECT_EQ(trie.insert("romanus", 2), OperationResult::Success, result);
+    EXPECT_EQ(trie.insert("rubens", 3), OperationResult::Success, result);
+    EXPECT_EQ(trie.insert("rom", 4), OperationResult::Success, result);
+    EXPECT_EQ(trie.amount(), 4, result);
+
+    EXPECT_EQ(*trie.find("romane"), 1, result);
+    EXPECT_EQ(*trie.find("romanus"), 2, result);
+    EXPECT_EQ(*trie.find("rubens"), 3, result);
+    EXPECT_EQ(*trie.find("rom"), 4, result);
+    EXPECT_EQ(trie.find("roman"), nullptr, result);
+    EndTestcase(result);
+}
+
+TEST(testLongestPrefix) {
+    BeginTestcase(result);
+    RadixTrieNode<int> nodes[16];
+    RadixTrie<int> trie(nodes, 16);
+
+    trie.insert("AT+", 1);
+    trie.insert("AT+RST", 2);
+    trie.insert("AT+GMR", 3);
+
+    size_t matched = 0;
+    EXPECT_EQ(*trie.longestPrefix("AT+RST\r\n", &matched), 2, result);
+    EXPECT_EQ(matched, 6, result);
+    EXPECT_EQ(*trie.longestPrefix("AT+CWMODE=1", &matched), 1, result);
+    EXPECT_EQ(matched, 3, result);
+    EXPECT_EQ(trie.longestPrefix("ATE0"), nullptr, result);
+    EndTestcase(result);
+}
+
+const TestFunction tests[] = {
+    testInsertAndFind,
+    testLongestPrefix,
+};
+
+const size_t testCount = sizeof(tests) / sizeof(TestFunction);
+
+}  // namespace collection2tests
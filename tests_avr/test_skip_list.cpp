@@ -0,0 +1,72 @@
+//
+// スキップリストのテスト
+//
+
+#include <stdint.h>
+
+#include "collection2/skip_list.hpp"
+#include "testcase.hpp"
+
+using namespace collection2;
+
+namespace collection2tests {
+
+TEST(testInsertAndIterate) {
+    BeginTestcase(result);
+    SkipListNode<int, uint8_t> nodes[8];
+    SkipListIndex<int, uint8_t> indices[8];
+    SkipList<int, uint8_t, 4> list(nodes, 8, indices, 8);
+
+    const int values[] = {5, 1, 4, 1, 3, 9, 2, 6};
+    for (int value : values) {
+        EXPECT_EQ(list.insert(value), OperationResult::Success, result);
+    }
+    EXPECT_EQ(list.insert(0), OperationResult::Overflow, result);
+
+    // 先頭からたどると昇順に並んでいる
+    const int expected[] = {1, 1, 2, 3, 4, 5, 6, 9};
+    int index = 0;
+    for (auto* node = list.head(); node != nullptr; node = node->next) {
+        EXPECT_EQ(node->element, expected[index++], result);
+    }
+    EXPECT_EQ(index, 8, result);
+    EndTestcase(result);
+}
+
+TEST(testFindRemoveAndPop) {
+    BeginTestcase(result);
+    SkipListNode<int, uint8_t> nodes[32];
+    SkipListIndex<int, uint8_t> indices[32];
+    SkipList<int, uint8_t, 6> list(nodes, 32, indices, 32);
+    for (int i = 0; i < 32; i++) {
+        list.insert((i * 7) % 32);
+    }
+
+    EXPECT_EQ(*list.find(12), 12, result);
+    EXPECT_EQ(list.remove(12), OperationResult::Success, result);
+    EXPECT_EQ(list.find(12), nullptr, result);
+    EXPECT_EQ(list.remove(12), OperationResult::Empty, result);
+    EXPECT_EQ(list.lowerBound(12)->element, 13, result);
+
+    // 取り出すと昇順に得られる
+    int previous = -1;
+    bool isOrdered = true;
+    int value = 0;
+    while (list.pop(&value) == OperationResult::Success) {
+        isOrdered = isOrdered && previous < value;
+        previous = value;
+    }
+    EXPECT_TRUE(isOrdered, result);
+    EXPECT_EQ(previous, 31, result);
+    EXPECT_TRUE(list.isEmpty(), result);
+    EndTestcase(result);
+}
+
+const TestFunction tests[] = {
+    testInsertAndIterate,
+    testFindRemoveAndPop,
+};
+
+const size_t testCount = sizeof(tests) / sizeof(TestFunction);
+
+}  // namespace collection2tests
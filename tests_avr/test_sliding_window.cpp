@@ -0,0 +1,74 @@
+//
+// スライディングウィンドウのテスト
+//
+
+#include <stdint.h>
+
+#include "collection2/sliding_window.hpp"
+#include "testcase.hpp"
+
+using namespace collection2;
+
+namespace collection2tests {
+
+TEST(testAggregatesMatchRecomputation) {
+    BeginTestcase(result);
+    const int windowLength = 8;
+    SlidingWindowSlot<int16_t, uint8_t> slots[windowLength];
+    SlidingWindow<int16_t, uint8_t, int32_t> window(slots, windowLength);
+
+    // 通し番号が一周する程度まで追加し、毎回全体を計算し直した値と比較する
+    int16_t history[300];
+    uint16_t seed = 1;
+    for (int i = 0; i < 300; i++) {
+        seed = seed * 25173 + 13849;
+        history[i] = static_cast<int16_t>(seed % 2001) - 1000;
+        window.append(history[i]);
+
+        const int first = i + 1 < windowLength ? 0 : i + 1 - windowLength;
+        int16_t expectedMin = history[first];
+        int16_t expectedMax = history[first];
+        int32_t expectedSum = 0;
+        for (int j = first; j <= i; j++) {
+            expectedMin = history[j] < expectedMin ? history[j] : expectedMin;
+            expectedMax = history[j] > expectedMax ? history[j] : expectedMax;
+            expectedSum += history[j];
+        }
+        EXPECT_EQ(*window.minimum(), expectedMin, result);
+        EXPECT_EQ(*window.maximum(), expectedMax, result);
+        EXPECT_EQ(window.sum(), expectedSum, result);
+    }
+    EndTestcase(result);
+}
+
+TEST(testPopAndClear) {
+    BeginTestcase(result);
+    SlidingWindowSlot<int> slots[4];
+    SlidingWindow<int> window(slots, 4);
+    EXPECT_EQ(window.minimum(), nullptr, result);
+
+    window.append(3);
+    window.append(1);
+    window.append(2);
+
+    // 最も古い要素を取り出すと、集計値からも外れる
+    int value = 0;
+    EXPECT_EQ(window.pop(&value), OperationResult::Success, result);
+    EXPECT_EQ(value, 3, result);
+    EXPECT_EQ(*window.maximum(), 2, result);
+    EXPECT_EQ(window.sum(), 3, result);
+
+    window.clear();
+    EXPECT_TRUE(window.isEmpty(), result);
+    EXPECT_EQ(window.pop(nullptr), OperationResult::Empty, result);
+    EndTestcase(result);
+}
+
+const TestFunction tests[] = {
+    testAggregatesMatchRecomputation,
+    testPopAndClear,
+};
+
+const size_t testCount = sizeof(tests) / sizeof(TestFunction);
+
+}  // namespace collection2tests
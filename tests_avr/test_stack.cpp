@@ -102,14 +102,70 @@ TEST(testOperateWithOneSize) {
     EndTestcase(result);
 }
 
+TEST(testBulkOperation) {
+    BeginTestcase(result);
+    const int stackLength = 10;
+    int stackData[stackLength] = {0};
+    Stack<int> stack(stackData, stackLength);
+
+    // まとめて追加
+    int source[] = {1, 2, 3, 4, 5, 6};
+    EXPECT_EQ(stack.pushN(source, 6), OperationResult::Success, result);
+    EXPECT_EQ(stack.pushN(source, 5), OperationResult::Overflow, result);
+    EXPECT_EQ(*stack.top(), 6, result);
+
+    // 積まれていた順に取り出される
+    int destination[3] = {0};
+    EXPECT_EQ(stack.popN(destination, 3), OperationResult::Success, result);
+    EXPECT_EQ(destination[0], 4, result);
+    EXPECT_EQ(destination[1], 5, result);
+    EXPECT_EQ(destination[2], 6, result);
+    EXPECT_EQ(stack.popN(destination, 4), OperationResult::Empty, result);
+    EXPECT_EQ(stack.amount(), 3, result);
+    EndTestcase(result);
+}
+
+TEST(testDualStack) {
+    BeginTestcase(result);
+    const int stackLength = 8;
+    int stackData[stackLength] = {0};
+    DualStack<int> stack(stackData, stackLength);
+
+    // 境界は固定されず、合計で領域長まで追加できる
+    for (int i = 0; i < 5; i++) {
+        EXPECT_EQ(stack.push(DualStackSide::Lower, i + 1), OperationResult::Success, result);
+    }
+    for (int i = 0; i < 3; i++) {
+        EXPECT_EQ(stack.push(DualStackSide::Upper, (i + 1) * 10), OperationResult::Success, result);
+    }
+    EXPECT_EQ(stack.push(DualStackSide::Lower, 0), OperationResult::Overflow, result);
+    EXPECT_EQ(stack.push(DualStackSide::Upper, 0), OperationResult::Overflow, result);
+
+    // それぞれ後入れ先出しで取り出せる
+    int value = 0;
+    for (int i = 3; i > 0; i--) {
+        EXPECT_EQ(stack.pop(DualStackSide::Upper, &value), OperationResult::Success, result);
+        EXPECT_EQ(value, i * 10, result);
+    }
+    EXPECT_EQ(stack.pop(DualStackSide::Upper, &value), OperationResult::Empty, result);
+    for (int i = 5; i > 0; i--) {
+        EXPECT_EQ(stack.pop(DualStackSide::Lower, &value), OperationResult::Success, result);
+        EXPECT_EQ(value, i, result);
+    }
+    EXPECT_EQ(stack.pop(DualStackSide::Lower, &value), OperationResult::Empty, result);
+    EndTestcase(result);
+}
+
 const TestFunction tests[] = {
     testInstantiate,
     testCapacityAndAmount,
     testOperate,
     testOperateWithZeroSize,
     testOperateWithOneSize,
+    testBulkOperation,
+    testDualStack,
 };
 
-const size_t testCount = 5;
+const size_t testCount = 7;
 
 }  // namespace collection2tests
@@ -2,6 +2,8 @@
 // リストのテスト
 //
 
+#include <stdint.h>
+
 #include "collection2/tree.hpp"
 #include "testcase.hpp"
 
@@ -78,10 +80,156 @@ TEST(testRemove) {
     EndTestcase(result);
 }
 
+TEST(testFreeze) {
+    BeginTestcase(result);
+    const int nodeCount = 15;
+    TreeNode<int> nodePool[nodeCount];
+    Tree<int> tree(nodePool, nodeCount);
+
+    // 右にだけ伸びた二分探索木 0, 10, ..., 140
+    auto* rootNode = tree.retainNode(0);
+    auto* node = rootNode;
+    for (int i = 1; i < nodeCount; i++) {
+        tree.appendChild(node, i * 10, TreeNodeSide::Right, &node);
+    }
+
+    int frozenData[nodeCount];
+    FrozenTree<int> frozen(frozenData, nodeCount);
+    EXPECT_EQ(tree.freeze(rootNode, frozen), OperationResult::Success, result);
+
+    // 完全二分木として書き出され、先頭は中央値になる
+    EXPECT_EQ(frozenData[0], 70, result);
+    for (int i = 0; i < nodeCount; i++) {
+        EXPECT_NE(frozen.find(i * 10), nullptr, result);
+        EXPECT_EQ(frozen.find(i * 10 + 5), nullptr, result);
+    }
+    EXPECT_EQ(*frozen.lowerBound(15), 20, result);
+    EXPECT_EQ(frozen.lowerBound(141), nullptr, result);
+    EndTestcase(result);
+}
+
+using RouteNode = TreeNode<int>;
+
+// 構築済みのツリーを静的に配置する
+RouteNode routeNodes[8] = {
+    RouteNode(50, &routeNodes[1], &routeNodes[2]),
+    RouteNode(25, &routeNodes[3]),
+    RouteNode(75),
+    RouteNode(10),
+};
+Tree<int> routeTree(routeNodes, 8, 4);
+
+TEST(testPrebuiltTree) {
+    BeginTestcase(result);
+    // 構築済みのノードは払い出し済みとして扱われる
+    EXPECT_EQ(routeTree.amount(), 4, result);
+    EXPECT_EQ(routeNodes[0].lhs->element, 25, result);
+    EXPECT_EQ(routeNodes[1].lhs->element, 10, result);
+
+    // 以降のノードは残りの領域から確保される
+    RouteNode* added = nullptr;
+    EXPECT_EQ(routeTree.appendChild(&routeNodes[2], 90, TreeNodeSide::Right, &added), OperationResult::Success, result);
+    EXPECT_EQ(added, &routeNodes[4], result);
+    EndTestcase(result);
+}
+
+TEST(testRotate) {
+    BeginTestcase(result);
+    using Node = TreeNode<int, size_t, true>;
+    Node nodePool[8];
+    Tree<int, size_t, true> tree(nodePool, 8);
+
+    // 10 - 20 - 30 と右に連なった木を回転する
+    auto* root = tree.retainNode(0);
+    Node* a = nullptr;
+    Node* b = nullptr;
+    tree.appendChild(root, 10, TreeNodeSide::Right, &a);
+    tree.appendChild(a, 20, TreeNodeSide::Right, &b);
+    tree.appendChild(b, 30, TreeNodeSide::Right);
+    tree.appendChild(b, 15, TreeNodeSide::Left);
+
+    EXPECT_EQ(tree.rotateLeft(a), b, result);
+    EXPECT_EQ(root->rhs, b, result);
+    EXPECT_EQ(b->parent, root, result);
+    EXPECT_EQ(a->parent, b, result);
+    EXPECT_EQ(a->rhs->element, 15, result);
+
+    // 部分木の置き換えと切り離し
+    EXPECT_EQ(tree.replaceSubtree(b, a), OperationResult::Success, result);
+    EXPECT_EQ(root->rhs, a, result);
+    EXPECT_EQ(b->lhs, nullptr, result);
+    EXPECT_EQ(tree.detach(a), OperationResult::Success, result);
+    EXPECT_EQ(root->rhs, nullptr, result);
+    EndTestcase(result);
+}
+
+TEST(testOrderStatistics) {
+    BeginTestcase(result);
+    using Node = TreeNode<int, uint8_t, true, SubtreeSize>;
+    using CountedTree = Tree<int, uint8_t, true, SubtreeSize>;
+    Node nodePool[8];
+    CountedTree tree(nodePool, 8);
+
+    /// 40を根とし、20, 60 を子に、10, 30, 50 を孫に持つ二分探索木
+    auto* root = tree.retainNode(40);
+    Node* left = nullptr;
+    Node* right = nullptr;
+    tree.appendChild(root, 20, TreeNodeSide::Left, &left);
+    tree.appendChild(root, 60, TreeNodeSide::Right, &right);
+    tree.appendChild(left, 10, TreeNodeSide::Left);
+    tree.appendChild(left, 30, TreeNodeSide::Right);
+    tree.appendChild(right, 50, TreeNodeSide::Left);
+    EXPECT_EQ(CountedTree::subtreeSizeOf(root), 6, result);
+
+    const int sorted[] = {10, 20, 30, 40, 50, 60};
+    for (uint8_t k = 0; k < 6; k++) {
+        auto* node = tree.select(root, k);
+        EXPECT_EQ(node->element, sorted[k], result);
+        EXPECT_EQ(tree.rank(node), k, result);
+    }
+    EXPECT_EQ(tree.select(root, 6), nullptr, result);
+    EXPECT_EQ(tree.countLess(root, 45), 4, result);
+
+    // 子孫を削除すると祖先のノード数も減る
+    tree.removeChild(left);
+    EXPECT_EQ(CountedTree::subtreeSizeOf(root), 4, result);
+    EXPECT_EQ(tree.amount(), 4, result);
+    EndTestcase(result);
+}
+
+TEST(testBuildBalanced) {
+    BeginTestcase(result);
+    const int sorted[] = {1, 2, 3, 4, 5, 6, 7};
+    TreeNode<int, uint8_t> nodePool[8];
+    Tree<int, uint8_t> tree(nodePool, 8);
+
+    // 中央の要素が根になり、各段が埋まった木になる
+    TreeNode<int, uint8_t>* root = nullptr;
+    EXPECT_EQ(tree.buildBalanced(sorted, 7, &root), OperationResult::Success, result);
+    EXPECT_EQ(root->element, 4, result);
+    EXPECT_EQ(root->lhs->element, 2, result);
+    EXPECT_EQ(root->rhs->element, 6, result);
+    EXPECT_EQ(root->lhs->lhs->element, 1, result);
+    EXPECT_EQ(root->rhs->rhs->element, 7, result);
+    EXPECT_TRUE(root->rhs->rhs->isLeaf(), result);
+
+    // ノードは要素と同じ順序で並ぶ
+    for (int i = 0; i < 7; i++) {
+        EXPECT_EQ(nodePool[i].element, sorted[i], result);
+    }
+    EXPECT_EQ(tree.buildBalanced(sorted, 2, &root), OperationResult::Overflow, result);
+    EndTestcase(result);
+}
+
 const TestFunction tests[] = {
     testBasicOperation,
     testDuplicate,
     testRemove,
+    testFreeze,
+    testPrebuiltTree,
+    testRotate,
+    testOrderStatistics,
+    testBuildBalanced,
 };
 
 const size_t testCount = sizeof(tests) / sizeof(TestFunction);
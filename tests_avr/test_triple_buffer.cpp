@@ -0,0 +1,64 @@
+//
+// トリプルバッファのテスト
+//
+
+#include <stdint.h>
+
+#include "collection2/interrupt.hpp"
+#include "collection2/triple_buffer.hpp"
+#include "testcase.hpp"
+
+using namespace collection2;
+
+namespace collection2tests {
+
+TEST(testLatestValueWins) {
+    BeginTestcase(result);
+    int data[3] = {0};
+    TripleBuffer<int> buffer(data);
+
+    // 取り出す前に何度公開しても、受け取るのは最後の値だけ
+    int value = 0;
+    EXPECT_EQ(buffer.read(&value), OperationResult::Empty, result);
+    for (int i = 1; i <= 5; i++) {
+        EXPECT_EQ(buffer.write(i), OperationResult::Success, result);
+    }
+    EXPECT_EQ(buffer.read(&value), OperationResult::Success, result);
+    EXPECT_EQ(value, 5, result);
+    EXPECT_EQ(buffer.read(&value), OperationResult::Empty, result);
+
+    // 受け取った値は、次に更新するまで書き換えられない
+    buffer.write(6);
+    buffer.write(7);
+    EXPECT_EQ(buffer.readSlot(), 5, result);
+    EXPECT_TRUE(buffer.update(), result);
+    EXPECT_EQ(buffer.readSlot(), 7, result);
+    EndTestcase(result);
+}
+
+TEST(testInterruptPolicy) {
+    BeginTestcase(result);
+    uint16_t samples[3] = {0};
+    TripleBuffer<uint16_t, InterruptToMain> buffer(samples);
+
+    // 割り込みハンドラが書き込み、メインループが最新の値を読む想定
+    for (uint16_t i = 0; i < 300; i++) {
+        *buffer.writeSlot() = i;
+        buffer.publish();
+        if (i % 7 == 0) {
+            EXPECT_TRUE(buffer.update(), result);
+            EXPECT_EQ(buffer.readSlot(), i, result);
+        }
+    }
+    EXPECT_TRUE(buffer.hasUpdate(), result);
+    EndTestcase(result);
+}
+
+const TestFunction tests[] = {
+    testLatestValueWins,
+    testInterruptPolicy,
+};
+
+const size_t testCount = sizeof(tests) / sizeof(TestFunction);
+
+}  // namespace collection2tests